@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Compile-time benchmark of freezing pipeline.
+
+Generates translation units which freeze tables of different kinds and sizes, compiles every one of them
+and writes JSON report with wall time, peak RSS of compiler, frontend time from -ftime-trace (clang) and
+minimal -fconstexpr-steps needed for the table (clang, with --find-steps).
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+KINDS = {
+    "vector": {
+        "includes": ["vector"],
+        "type": "std::vector<int>",
+        "body": """    std::vector<int> result;
+    for (std::size_t i = 0; i < TableSize; ++i)
+    {
+        result.push_back(static_cast<int>(i * 7 % 1000));
+    }
+    return result;""",
+        "result_size": "TableSize",
+    },
+    "string": {
+        "includes": ["string"],
+        "type": "std::string",
+        "body": """    std::string result;
+    for (std::size_t i = 0; i < TableSize; ++i)
+    {
+        result += static_cast<char>('a' + i % 26);
+    }
+    return result;""",
+        "result_size": "TableSize",
+    },
+    "unordered_map": {
+        "includes": ["constexpr_std/unordered_map"],
+        "type": "std::unordered_map<int, int>",
+        "body": """    std::unordered_map<int, int> result;
+    for (std::size_t i = 0; i < TableSize; ++i)
+    {
+        result.emplace(static_cast<int>(i), static_cast<int>(i * i));
+    }
+    return result;""",
+        "result_size": "TableSize",
+        "clang_only": True,
+    },
+    # TableSize values in rows of 100 values
+    "nested": {
+        "includes": ["vector"],
+        "type": "std::vector<std::vector<int>>",
+        "body": """    constexpr std::size_t Rows = TableSize < 100 ? 1 : TableSize / 100;
+    std::vector<std::vector<int>> result(Rows);
+    for (std::size_t i = 0; i < TableSize; ++i)
+    {
+        result[i % Rows].push_back(static_cast<int>(i));
+    }
+    return result;""",
+        "result_size": "(TableSize < 100 ? 1 : TableSize / 100)",
+    },
+    # TableSize characters in rows of 10 strings of 10 characters
+    "multi_level": {
+        "includes": ["string", "vector"],
+        "type": "std::vector<std::vector<std::string>>",
+        "body": """    constexpr std::size_t Rows = TableSize < 100 ? 1 : TableSize / 100;
+    std::vector<std::vector<std::string>> result(Rows);
+    for (std::size_t i = 0; i < TableSize / 10; ++i)
+    {
+        result[i % Rows].push_back(std::string(10, static_cast<char>('a' + i % 26)));
+    }
+    return result;""",
+        "result_size": "(TableSize < 100 ? 1 : TableSize / 100)",
+    },
+}
+
+SIZES = [10, 100, 1000, 10000, 100000]
+
+
+def generate(template, kind, size, path):
+    description = KINDS[kind]
+    source = (template
+              .replace("@INCLUDES@", "\n".join(f"#include <{header}>" if "/" not in header else f"#include \"{header}\""
+                                               for header in description["includes"]))
+              .replace("@SIZE@", str(size))
+              .replace("@TYPE@", description["type"])
+              .replace("@BODY@", description["body"])
+              .replace("@RESULT_SIZE@", description["result_size"]))
+    with open(path, "w") as file:
+        file.write(source)
+
+
+def compile_case(args, source, extra_flags):
+    """Compiles source, returns (success, wall seconds, peak RSS KiB, compiler output)"""
+    obj = os.path.splitext(source)[0] + ".o"
+    command = [args.compiler, *args.flags, *[f"-I{path}" for path in args.include], *extra_flags, "-c", source, "-o", obj]
+
+    start = time.perf_counter()
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = process.stdout.read()
+    _, status, usage = os.wait4(process.pid, 0)
+    process.returncode = os.waitstatus_to_exitcode(status)
+    wall = time.perf_counter() - start
+
+    return process.returncode == 0, wall, usage.ru_maxrss, output.decode(errors="replace")
+
+
+def frontend_seconds(source):
+    """Total frontend time from -ftime-trace report of clang"""
+    trace = os.path.splitext(source)[0] + ".json"
+    if not os.path.exists(trace):
+        return None
+    with open(trace) as file:
+        events = json.load(file).get("traceEvents", [])
+    for event in events:
+        if event.get("name") == "Total Frontend":
+            return event["dur"] / 1e6
+    return None
+
+
+def find_steps(args, source):
+    """Minimal -fconstexpr-steps with precision of 10%, None if it's more than --max-steps"""
+    low, high = 0, 1 << 20
+    while not compile_case(args, source, [f"-fconstexpr-steps={high}"])[0]:
+        low = high
+        high *= 4
+        if high > args.max_steps:
+            return None
+    while high - low > max(1, high // 10):
+        middle = (low + high) // 2
+        if compile_case(args, source, [f"-fconstexpr-steps={middle}"])[0]:
+            high = middle
+        else:
+            low = middle
+    return high
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--compiler", required=True)
+    parser.add_argument("--flag", dest="flags", action="append", default=[], help="Compiler flag, e.g. --flag=-std=c++23")
+    parser.add_argument("--include", action="append", default=[])
+    parser.add_argument("--template", required=True)
+    parser.add_argument("--work-dir", required=True)
+    parser.add_argument("--output", required=True)
+    parser.add_argument("--kinds", default=",".join(KINDS))
+    parser.add_argument("--sizes", default=",".join(map(str, SIZES)))
+    parser.add_argument("--find-steps", action="store_true", help="Search minimal -fconstexpr-steps (clang only)")
+    parser.add_argument("--max-steps", type=int, default=1 << 32)
+    args = parser.parse_args()
+
+    version = subprocess.run([args.compiler, "--version"], capture_output=True, text=True).stdout
+    is_clang = "clang" in version
+    # Big tables must not fail on default limits, needed steps are measured separately by --find-steps
+    if is_clang:
+        args.flags = [*args.flags, "-ftime-trace", f"-fconstexpr-steps={args.max_steps}"]
+    elif "Free Software Foundation" in version:
+        args.flags = [*args.flags, f"-fconstexpr-ops-limit={args.max_steps}", f"-fconstexpr-loop-limit={min(args.max_steps, (1 << 31) - 1)}"]
+
+    with open(args.template) as file:
+        template = file.read()
+    os.makedirs(args.work_dir, exist_ok=True)
+
+    report = {"compiler": args.compiler, "flags": args.flags, "cases": []}
+
+    for kind in args.kinds.split(","):
+        if KINDS[kind].get("clang_only") and not is_clang:
+            continue
+
+        for size in map(int, args.sizes.split(",")):
+            source = os.path.join(args.work_dir, f"{kind}_{size}.cpp")
+            generate(template, kind, size, source)
+
+            success, wall, rss, output = compile_case(args, source, [])
+            case = {
+                "kind": kind,
+                "size": size,
+                "success": success,
+                "wall_seconds": round(wall, 3),
+                "peak_rss_kib": rss,
+                "frontend_seconds": frontend_seconds(source) if success and is_clang else None,
+                "constexpr_steps": find_steps(args, source) if success and is_clang and args.find_steps else None,
+            }
+            if not success:
+                case["error"] = next((line for line in output.splitlines() if re.search(r"error", line)), output[:200])
+
+            report["cases"].append(case)
+            print(f"{kind:>14} {size:>7}: {'ok' if success else 'failed':>6} {wall:8.2f} s {rss / 1024:8.1f} MiB", flush=True)
+
+    with open(args.output, "w") as file:
+        json.dump(report, file, indent=2)
+
+    return 0 if all(case["success"] for case in report["cases"]) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
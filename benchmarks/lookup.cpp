@@ -0,0 +1,51 @@
+#include "cant.h"
+#include "lookup.h"
+
+#if __clang__
+#include "constexpr_std/unordered_map"
+#endif
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr auto frozen_ints = cant::too_constexpr(
+            []() -> std::vector<int>
+            {
+                return lookup::make_ints<std::vector<int>>();
+            }
+    );
+
+    constexpr auto frozen_string = cant::too_constexpr(
+            []() -> std::string
+            {
+                return lookup::make_string<std::string>();
+            }
+    );
+
+#if __clang__
+    // std::unordered_map is constexpr port here, standard one is benchmarked by lookup_std_benchmark
+    constexpr auto frozen_map = cant::too_constexpr(
+            []() -> std::unordered_map<int, int>
+            {
+                return lookup::make_map<std::unordered_map<int, int>>();
+            }
+    );
+#endif
+}
+
+int main()
+{
+    auto hits = lookup::make_keys(true);
+    auto misses = lookup::make_keys(false);
+
+    lookup::benchmark_vector("frozen vector<int>", frozen_ints, hits, misses);
+    lookup::benchmark_string("frozen string", frozen_string);
+
+#if __clang__
+    lookup::benchmark_map("frozen unordered_map<int, int>", frozen_map, hits, misses);
+#endif
+
+    return 0;
+}
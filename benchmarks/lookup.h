@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tables and measurements shared by frozen containers (lookup.cpp) and standard containers (lookup_std.cpp)
+ * @details Header doesn't include any map, because constexpr port of std::unordered_map and standard one
+ *          can't be used in the same program, so they are benchmarked by different executables
+ */
+namespace lookup
+{
+    constexpr std::size_t TableSize = 4096;
+    constexpr std::size_t Iterations = 1000000;
+    constexpr std::size_t CopyIterations = 100000;
+
+    // Even keys are stored in tables, odd keys are missed
+    template<typename Vector>
+    constexpr Vector make_ints()
+    {
+        Vector result;
+        for (std::size_t i = 0; i < TableSize; ++i)
+        {
+            result.push_back(static_cast<int>(i * 2));
+        }
+        return result;
+    }
+
+    template<typename String>
+    constexpr String make_string()
+    {
+        String result;
+        for (std::size_t i = 0; i < TableSize; ++i)
+        {
+            result += static_cast<char>('a' + i % 16);
+        }
+        return result;
+    }
+
+    template<typename Map>
+    constexpr Map make_map()
+    {
+        Map result;
+        for (std::size_t i = 0; i < TableSize; ++i)
+        {
+            result.emplace(static_cast<int>(i * 2), static_cast<int>(i));
+        }
+        return result;
+    }
+
+    inline volatile std::size_t sink;
+
+    /**
+     * @brief Pseudo-random keys, so lookups aren't predicted by branch predictor
+     */
+    inline std::vector<int> make_keys(bool hit)
+    {
+        std::vector<int> result(Iterations);
+        std::uint32_t state = 12345;
+        for (auto& key : result)
+        {
+            state = state * 1664525 + 1013904223;
+            key = static_cast<int>(state % TableSize) * 2 + (hit ? 0 : 1);
+        }
+        return result;
+    }
+
+    template<typename Operation>
+    std::size_t run(Operation& operation, std::size_t iterations)
+    {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            result += operation(i);
+        }
+        return result;
+    }
+
+    template<typename Operation>
+    double measure_ns(Operation operation, std::size_t iterations = Iterations)
+    {
+        auto start = std::chrono::steady_clock::now();
+        sink = sink + run(operation, iterations);
+        auto finish = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(finish - start).count() / iterations;
+    }
+
+    /**
+     * @return Total throughput of threads_num threads in operations per second
+     */
+    template<typename Operation>
+    double measure_throughput(Operation operation, unsigned threads_num)
+    {
+        std::atomic<std::size_t> result {};
+        std::vector<std::thread> threads;
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < threads_num; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                auto thread_operation = operation;
+                result += run(thread_operation, Iterations);
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto finish = std::chrono::steady_clock::now();
+
+        sink = sink + result;
+        return static_cast<double>(Iterations) * threads_num / std::chrono::duration<double>(finish - start).count();
+    }
+
+    inline void report(const char* name, double ns)
+    {
+        std::printf("%-40s %10.1f ns/op %10.1f Mops/s\n", name, ns, 1e3 / ns);
+    }
+
+    template<typename Operation>
+    void report_scaling(const char* name, Operation operation)
+    {
+        auto max_threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned threads_num = 1; threads_num <= max_threads; threads_num *= 2)
+        {
+            auto ops = measure_throughput(operation, threads_num);
+            std::printf("%-40s %3u threads %10.1f Mops/s\n", name, threads_num, ops / 1e6);
+        }
+    }
+
+    template<typename Vector>
+    void benchmark_vector(const char* name, const Vector& vector, const std::vector<int>& hits, const std::vector<int>& misses)
+    {
+        std::string prefix = name;
+
+        auto hit = [&](std::size_t i) { return static_cast<std::size_t>(std::binary_search(vector.begin(), vector.end(), hits[i])); };
+        auto miss = [&](std::size_t i) { return static_cast<std::size_t>(std::binary_search(vector.begin(), vector.end(), misses[i])); };
+
+        report((prefix + " hit").c_str(), measure_ns(hit));
+        report((prefix + " miss").c_str(), measure_ns(miss));
+        report((prefix + " iteration").c_str(), measure_ns([&](std::size_t)
+        {
+            std::size_t result = 0;
+            for (auto value : vector)
+            {
+                result += static_cast<std::size_t>(value);
+            }
+            return result;
+        }, CopyIterations) / TableSize);
+        report((prefix + " copy").c_str(), measure_ns([&](std::size_t i)
+        {
+            Vector copy(vector);
+            return copy.size() + static_cast<std::size_t>(copy[i % copy.size()]);
+        }, CopyIterations));
+        report_scaling((prefix + " hit").c_str(), hit);
+    }
+
+    template<typename String>
+    void benchmark_string(const char* name, const String& string)
+    {
+        std::string prefix = name;
+
+        auto find_hit = [&](std::size_t i) { return string.find(static_cast<char>('a' + i % 16)); };
+
+        report((prefix + " find hit").c_str(), measure_ns(find_hit));
+        report((prefix + " find miss").c_str(), measure_ns([&](std::size_t) { return string.find('z'); }, CopyIterations));
+        report((prefix + " iteration").c_str(), measure_ns([&](std::size_t)
+        {
+            std::size_t result = 0;
+            for (auto character : string)
+            {
+                result += static_cast<std::size_t>(character);
+            }
+            return result;
+        }, CopyIterations) / TableSize);
+        report((prefix + " copy").c_str(), measure_ns([&](std::size_t i)
+        {
+            String copy(string);
+            return copy.size() + static_cast<std::size_t>(copy[i % copy.size()]);
+        }, CopyIterations));
+        report_scaling((prefix + " find hit").c_str(), find_hit);
+    }
+
+    template<typename Map>
+    void benchmark_map(const char* name, const Map& map, const std::vector<int>& hits, const std::vector<int>& misses)
+    {
+        std::string prefix = name;
+
+        auto hit = [&](std::size_t i) { return static_cast<std::size_t>(map.find(hits[i]) != map.end()); };
+        auto miss = [&](std::size_t i) { return static_cast<std::size_t>(map.find(misses[i]) != map.end()); };
+
+        report((prefix + " hit").c_str(), measure_ns(hit));
+        report((prefix + " miss").c_str(), measure_ns(miss));
+        report((prefix + " iteration").c_str(), measure_ns([&](std::size_t)
+        {
+            std::size_t result = 0;
+            for (const auto& [key, value] : map)
+            {
+                result += static_cast<std::size_t>(value);
+            }
+            return result;
+        }, CopyIterations / 10) / TableSize);
+        report((prefix + " copy").c_str(), measure_ns([&](std::size_t i)
+        {
+            Map copy(map);
+            return copy.size() + copy.count(hits[i]);
+        }, CopyIterations / 100));
+        report_scaling((prefix + " hit").c_str(), hit);
+    }
+}
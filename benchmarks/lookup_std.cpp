@@ -0,0 +1,24 @@
+#include "lookup.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Standard containers aren't compiled with constexpr port of std::unordered_map, so this is real standard library.
+// Program doesn't contain port, so its containers are constructed at runtime and compared with lookup_benchmark
+
+int main()
+{
+    auto hits = lookup::make_keys(true);
+    auto misses = lookup::make_keys(false);
+
+    const auto std_ints = lookup::make_ints<std::vector<int>>();
+    const auto std_string = lookup::make_string<std::string>();
+    const auto std_map = lookup::make_map<std::unordered_map<int, int>>();
+
+    lookup::benchmark_vector("std::vector<int>", std_ints, hits, misses);
+    lookup::benchmark_string("std::string", std_string);
+    lookup::benchmark_map("std::unordered_map<int, int>", std_map, hits, misses);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include "cant.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t TableSize = 1024;
+    constexpr std::size_t Iterations = 100000;
+
+    constexpr auto frozen_ints = cant::too_constexpr(
+            []() -> std::vector<int>
+            {
+                std::vector<int> result;
+                for (std::size_t i = 0; i < TableSize; ++i)
+                {
+                    result.push_back(static_cast<int>(i));
+                }
+                return result;
+            }
+    );
+
+    constexpr auto frozen_string = cant::too_constexpr(
+            []() -> std::string
+            {
+                return std::string(TableSize, 'x');
+            }
+    );
+
+    volatile std::size_t sink;
+
+    template<typename Container>
+    double copy_ns(const Container& container)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < Iterations; ++i)
+        {
+            Container copy(container);
+            sink = sink + copy.size() + static_cast<std::size_t>(copy[i % copy.size()]);
+        }
+        auto finish = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(finish - start).count() / Iterations;
+    }
+
+    void report(const char* name, double ns)
+    {
+        std::printf("%-24s %10.1f ns/copy\n", name, ns);
+    }
+}
+
+int main()
+{
+    std::vector<int> std_ints(frozen_ints.begin(), frozen_ints.end());
+    std::string std_string(frozen_string.begin(), frozen_string.end());
+
+    report("frozen vector<int>", copy_ns(frozen_ints));
+    report("std::vector<int>", copy_ns(std_ints));
+    report("frozen string", copy_ns(frozen_string));
+    report("std::string", copy_ns(std_string));
+
+    return 0;
+}
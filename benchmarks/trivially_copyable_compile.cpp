@@ -0,0 +1,76 @@
+#include "cant.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+constexpr std::size_t TableSize = 4096;
+
+#ifdef CANT_BENCHMARK_ELEMENTWISE_COPY
+/**
+ * @brief Value with user-provided copy, which isn't trivially copyable, so containers copy it element by element
+ */
+template<typename T>
+struct elementwise_t
+{
+    T value {};
+
+    constexpr elementwise_t() = default;
+    constexpr elementwise_t(T value) : value(value) {}
+    constexpr elementwise_t(const elementwise_t& rhs) : value(rhs.value) {}
+    constexpr elementwise_t& operator=(const elementwise_t& rhs)
+    {
+        value = rhs.value;
+        return *this;
+    }
+};
+
+template<typename T>
+using element_t = elementwise_t<T>;
+
+static_assert(!std::is_trivially_copyable_v<element_t<int>>, "error");
+#else
+template<typename T>
+using element_t = T;
+#endif
+
+constexpr auto int_table = cant::too_constexpr(
+        []() -> std::vector<element_t<int>>
+        {
+            std::vector<element_t<int>> result;
+            for (std::size_t i = 0; i < TableSize; ++i)
+            {
+                result.push_back(static_cast<int>(i * 7 % 1000));
+            }
+            return result;
+        }
+);
+
+constexpr auto double_table = cant::too_constexpr(
+        []() -> std::vector<element_t<double>>
+        {
+            std::vector<element_t<double>> result;
+            for (std::size_t i = 0; i < TableSize; ++i)
+            {
+                result.push_back(static_cast<double>(i) / 8);
+            }
+            return result;
+        }
+);
+
+// Characters can't be wrapped, so string table is the same in both builds
+constexpr auto string_table = cant::too_constexpr(
+        []() -> std::string
+        {
+            std::string result;
+            for (std::size_t i = 0; i < TableSize; ++i)
+            {
+                result += static_cast<char>('a' + i % 26);
+            }
+            return result;
+        }
+);
+
+static_assert(int_table.size() == TableSize, "error");
+static_assert(double_table.size() == TableSize, "error");
+static_assert(string_table.size() == TableSize, "error");
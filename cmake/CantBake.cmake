@@ -0,0 +1,32 @@
+set(CANT_BAKE_TEMPLATE ${CMAKE_CURRENT_LIST_DIR}/bake_main.cpp.in)
+set(CANT_INCLUDE_DIR ${CMAKE_CURRENT_LIST_DIR}/../include)
+
+# Bakes result of initializer to generated header, so it isn't evaluated at compile time:
+#
+#   cant_bake(<name> HEADER <generated header> INCLUDE <header with initializer> INITIALIZER <expression>)
+#
+# INITIALIZER is expression of object which produces vector or string of arithmetic values when it is called.
+# Tool <name>_bake evaluates it at build time and writes constant <name> to HEADER,
+# target <name>_baked generates HEADER, targets which include it must depend on this target.
+function(cant_bake NAME)
+    cmake_parse_arguments(CANT_BAKE "" "HEADER;INCLUDE;INITIALIZER" "" ${ARGN})
+
+    if (NOT CANT_BAKE_HEADER OR NOT CANT_BAKE_INCLUDE OR NOT CANT_BAKE_INITIALIZER)
+        message(FATAL_ERROR "cant_bake: HEADER, INCLUDE and INITIALIZER are required")
+    endif()
+
+    set(CANT_BAKE_NAME ${NAME})
+    set(BAKE_SOURCE ${CMAKE_CURRENT_BINARY_DIR}/${NAME}_bake.cpp)
+    configure_file(${CANT_BAKE_TEMPLATE} ${BAKE_SOURCE} @ONLY)
+
+    add_executable(${NAME}_bake ${BAKE_SOURCE})
+    target_include_directories(${NAME}_bake PRIVATE ${CANT_INCLUDE_DIR} ${CMAKE_CURRENT_SOURCE_DIR})
+
+    add_custom_command(
+            OUTPUT ${CANT_BAKE_HEADER}
+            COMMAND ${NAME}_bake ${CANT_BAKE_HEADER}
+            DEPENDS ${NAME}_bake
+            COMMENT "Baking ${NAME}")
+
+    add_custom_target(${NAME}_baked DEPENDS ${CANT_BAKE_HEADER})
+endfunction()
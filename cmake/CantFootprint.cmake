@@ -0,0 +1,36 @@
+set(CANT_FOOTPRINT_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/footprint_report.py)
+
+# Adds target <target>_footprint, which reports sizes of .rodata, .data.rel.ro and .data of ELF binary of target and
+# size and number of dynamic relocations of every object in them:
+#
+#   cant_footprint_report(<target> [SYMBOLS <regex>])
+#
+# SYMBOLS filters reported objects by name, report is also written to <target>_footprint.json.
+function(cant_footprint_report TARGET)
+    cmake_parse_arguments(CANT_FOOTPRINT "" "SYMBOLS" "" ${ARGN})
+
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+
+    set(READELF ${CMAKE_READELF})
+    if (NOT READELF)
+        set(READELF readelf)
+    endif()
+    set(NM ${CMAKE_NM})
+    if (NOT NM)
+        set(NM nm)
+    endif()
+
+    if (CANT_FOOTPRINT_SYMBOLS)
+        set(SYMBOLS_ARGS --symbols ${CANT_FOOTPRINT_SYMBOLS})
+    endif()
+
+    add_custom_target(${TARGET}_footprint
+            COMMAND Python3::Interpreter ${CANT_FOOTPRINT_SCRIPT} $<TARGET_FILE:${TARGET}>
+                --readelf ${READELF}
+                --nm ${NM}
+                --output ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_footprint.json
+                ${SYMBOLS_ARGS}
+            DEPENDS ${TARGET}
+            USES_TERMINAL
+            COMMENT "Footprint of frozen objects of ${TARGET}")
+endfunction()
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Footprint report of frozen objects in ELF binary.
+
+Reports sizes of .rodata, .data.rel.ro and .data sections and, for every object symbol in them, its size and
+number of dynamic relocations (pointers which are patched by dynamic loader at startup of PIE binary).
+"""
+
+import argparse
+import bisect
+import json
+import re
+import subprocess
+import sys
+
+# Constant objects with pointers are placed to .data.rel.ro, but some compilers place frozen objects to .data
+SECTIONS = (".rodata", ".data.rel.ro", ".data")
+
+
+def run(*command):
+    return subprocess.run(command, capture_output=True, text=True, check=True).stdout
+
+
+def read_sections(readelf, binary):
+    """{name: (address, size)} of sections"""
+    result = {}
+    for line in run(readelf, "-SW", binary).splitlines():
+        match = re.match(r"\s*\[\s*\d+\]\s+(\S+)\s+\S+\s+([0-9a-f]+)\s+[0-9a-f]+\s+([0-9a-f]+)", line)
+        if match:
+            result[match.group(1)] = (int(match.group(2), 16), int(match.group(3), 16))
+    return result
+
+
+def read_symbols(nm, binary, sections, pattern):
+    """Sorted list of (address, size, section, name) of objects in SECTIONS"""
+    result = []
+    for line in run(nm, "-S", "-C", "--defined-only", binary).splitlines():
+        parts = line.split(maxsplit=3)
+        if len(parts) != 4:
+            continue
+        address, size, _, name = int(parts[0], 16), int(parts[1], 16), parts[2], parts[3]
+        if size == 0 or (pattern and not re.search(pattern, name)):
+            continue
+        for section in SECTIONS:
+            start, length = sections.get(section, (0, 0))
+            if start <= address < start + length:
+                result.append((address, size, section, name))
+    return sorted(result)
+
+
+def read_dynamic_relocations(readelf, binary):
+    """Sorted list of offsets of dynamic relocations (.rela.dyn or .rel.dyn)"""
+    result = []
+    dynamic = False
+    for line in run(readelf, "-rW", binary).splitlines():
+        section = re.match(r"Relocation section '(\S+)'", line)
+        if section:
+            dynamic = section.group(1) in (".rela.dyn", ".rel.dyn")
+            continue
+        match = re.match(r"\s*([0-9a-f]{8,})\s+[0-9a-f]+\s+R_", line)
+        if dynamic and match:
+            result.append(int(match.group(1), 16))
+    return sorted(result)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("binary")
+    parser.add_argument("--symbols", help="Regular expression of names of reported symbols")
+    parser.add_argument("--output", help="JSON report")
+    parser.add_argument("--readelf", default="readelf")
+    parser.add_argument("--nm", default="nm")
+    args = parser.parse_args()
+
+    sections = read_sections(args.readelf, args.binary)
+    symbols = read_symbols(args.nm, args.binary, sections, args.symbols)
+    relocations = read_dynamic_relocations(args.readelf, args.binary)
+
+    report = {
+        "binary": args.binary,
+        "sections": {name: sections.get(name, (0, 0))[1] for name in SECTIONS},
+        "dynamic_relocations": len(relocations),
+        "symbols": [],
+    }
+
+    for address, size, section, name in symbols:
+        relocations_num = bisect.bisect_left(relocations, address + size) - bisect.bisect_left(relocations, address)
+        report["symbols"].append({"name": name, "section": section, "size": size, "relocations": relocations_num})
+
+    report["symbols"].sort(key=lambda symbol: symbol["size"], reverse=True)
+
+    for name, size in report["sections"].items():
+        print(f"{name:<14} {size:>10} bytes")
+    print(f"{'relocations':<14} {report['dynamic_relocations']:>10}")
+    for symbol in report["symbols"]:
+        print(f"{symbol['size']:>10} bytes {symbol['relocations']:>6} relocations  {symbol['section']:<13} {symbol['name']}")
+
+    if args.output:
+        with open(args.output, "w") as file:
+            json.dump(report, file, indent=2)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,17 @@
+#include "cubes_baked.h"
+#include "alphabet_baked.h"
+
+static_assert(cubes.size() == 100 && cubes[99] == 970299, "error");
+static_assert(alphabet == "abcdefghijklmnopqrstuvwxyz" && alphabet.c_str()[26] == '\0', "error");
+
+constexpr long sum_cubes()
+{
+    long result = 0;
+    for (auto value : cubes)
+    {
+        result += value;
+    }
+    return result;
+}
+
+static_assert(sum_cubes() == 99L * 99 * 100 * 100 / 4, "error");
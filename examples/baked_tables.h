@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Initializers are usual initializers of too_constexpr, they are evaluated by bake tool at build time
+constexpr auto cubes_initializer = []() -> std::vector<long>
+{
+    std::vector<long> result;
+
+    for (long i = 0; i < 100; ++i)
+    {
+        result.push_back(i * i * i);
+    }
+
+    return result;
+};
+
+constexpr auto alphabet_initializer = []() -> std::string
+{
+    std::string result;
+
+    for (char c = 'a'; c <= 'z'; ++c)
+    {
+        result += c;
+    }
+
+    return result;
+};
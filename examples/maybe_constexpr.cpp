@@ -0,0 +1,48 @@
+#include "cant.h"
+
+#include <vector>
+
+constexpr auto small_table_initializer = []() -> std::vector<int>
+{
+    std::vector<int> result;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        result.push_back(i);
+    }
+
+    return result;
+};
+
+// Evaluation of big table at compile time exceeds constexpr limits
+constexpr auto big_table_initializer = []() -> std::vector<int>
+{
+    return std::vector<int>(10000000, 1);
+};
+
+// Small table fits budget, so it's frozen
+constexpr static auto small_table = cant::maybe_constexpr<10>(small_table_initializer);
+
+static_assert(small_table.frozen(), "error");
+
+// Payload of big table is bigger than 64 KiB, so it isn't evaluated at compile time and is constructed at first access
+constexpr static auto big_table = cant::maybe_constexpr<10000000, 64 * 1024>(big_table_initializer);
+
+static_assert(!big_table.frozen(), "error");
+
+// Both tables are accessed by the same handle type
+static_assert(std::is_same_v<decltype(small_table), decltype(big_table)>, "error");
+
+int sum_tables()
+{
+    int result = 0;
+    for (auto value : small_table)
+    {
+        result += value;
+    }
+    for (auto value : big_table)
+    {
+        result += value;
+    }
+    return result;
+}
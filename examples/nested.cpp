@@ -0,0 +1,71 @@
+#include "cant.h"
+
+#include <string>
+#include <vector>
+
+constexpr static auto constexpr_routes =
+    cant::too_constexpr(
+        []() -> std::vector<std::vector<int>>
+        {
+            std::vector<std::vector<int>> result;
+            for (int i = 0; i < 4; ++i)
+            {
+                result.emplace_back();
+                for (int j = 0; j <= i; ++j)
+                {
+                    result.back().push_back(i * 10 + j);
+                }
+            }
+            return result;
+        }
+    );
+
+static_assert(constexpr_routes.size() == 4, "error");
+static_assert(constexpr_routes[3].size() == 4 && constexpr_routes[3][2] == 32, "error");
+
+// Rows share one pool sized by all their values, so the long row doesn't enlarge storage of other rows
+constexpr static auto constexpr_skewed_routes =
+    cant::too_constexpr(
+        []() -> std::vector<std::vector<int>>
+        {
+            std::vector<std::vector<int>> result(100, std::vector<int>(1, 7));
+            result[5] = std::vector<int>(1000, 3);
+            return result;
+        }
+    );
+
+static_assert(constexpr_skewed_routes[5].size() == 1000 && constexpr_skewed_routes[6][0] == 7, "error");
+static_assert(cant::footprint(constexpr_skewed_routes).payload_bytes == 1099 * sizeof(int), "error");
+static_assert(
+    sizeof(constexpr_skewed_routes) <=
+        sizeof(std::vector<std::vector<int>>) + 100 * (sizeof(std::vector<int>) + sizeof(void*)) + 1099 * sizeof(int) + 4 * sizeof(void*),
+    "Storage of nested containers is bigger than their values"
+);
+
+constexpr static auto constexpr_strings =
+    cant::too_constexpr(
+        []() -> std::vector<std::string>
+        {
+            return { "short", "string which is too long for small string optimization", "" };
+        }
+    );
+
+static_assert(constexpr_strings[1] == "string which is too long for small string optimization", "error");
+static_assert(constexpr_strings[2].empty(), "error");
+
+#if __clang__
+
+#include "constexpr_std/unordered_map"
+
+constexpr static auto constexpr_routes_map =
+    cant::too_constexpr(
+        []() -> std::unordered_map<int, std::vector<int>>
+        {
+            return { {1, {11, 12}}, {2, {}}, {3, {31, 32, 33}} };
+        }
+    );
+
+static_assert(constexpr_routes_map.at(3)[2] == 33, "error");
+static_assert(constexpr_routes_map.at(2).empty(), "error");
+
+#endif
@@ -0,0 +1,38 @@
+#include "cant.h"
+
+#include <string>
+#include <vector>
+
+struct sequence_config_t
+{
+    int first;
+    int step;
+    std::size_t size;
+};
+
+constexpr auto sequence_builder = [](sequence_config_t config) -> std::vector<int>
+{
+    std::vector<int> result;
+
+    for (std::size_t i = 0; i < config.size; ++i)
+    {
+        result.push_back(config.first + static_cast<int>(i) * config.step);
+    }
+
+    return result;
+};
+
+constexpr static auto constexpr_odd = cant::too_constexpr<sequence_config_t { .first = 1, .step = 2, .size = 10 }>(sequence_builder);
+constexpr static auto constexpr_tens = cant::too_constexpr<sequence_config_t { .first = 0, .step = 10, .size = 5 }>(sequence_builder);
+
+static_assert(constexpr_odd.size() == 10 && constexpr_odd[9] == 19, "error");
+static_assert(constexpr_tens.size() == 5 && constexpr_tens[4] == 40, "error");
+
+constexpr auto greeting_builder = [](char first, std::size_t size) -> std::string
+{
+    return std::string(size, first);
+};
+
+constexpr static auto constexpr_greeting = cant::too_constexpr<'a', 20>(greeting_builder);
+
+static_assert(constexpr_greeting == "aaaaaaaaaaaaaaaaaaaa", "error");
@@ -0,0 +1,33 @@
+#include "cant.h"
+
+#include <vector>
+
+constexpr auto segment_builder = [](std::size_t segment) -> std::vector<int>
+{
+    std::vector<int> result;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        result.push_back(static_cast<int>(segment) * 100 + i);
+    }
+
+    return result;
+};
+
+constexpr static auto constexpr_segmented = cant::too_constexpr_segmented<4>(segment_builder);
+
+static_assert(constexpr_segmented.size() == 400, "error");
+static_assert(constexpr_segmented[0] == 0 && constexpr_segmented[250] == 250 && constexpr_segmented[399] == 399, "error");
+static_assert(constexpr_segmented.segment(2).size() == 100, "error");
+
+constexpr int sum_segmented()
+{
+    int result = 0;
+    for (auto value : constexpr_segmented)
+    {
+        result += value;
+    }
+    return result;
+}
+
+static_assert(sum_segmented() == 399 * 400 / 2, "error");
@@ -0,0 +1,14 @@
+#include "sharded.h"
+
+// View is constant initialized, shards are evaluated in their own translation units
+constinit const cant::sharded_t<int, 2> sorted_table { &sorted_shard_0, &sorted_shard_1 };
+
+bool sharded_contains(int value)
+{
+    return sorted_table.contains(value);
+}
+
+int sharded_at(std::size_t index)
+{
+    return sorted_table[index];
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "cant.h"
+
+#include <span>
+#include <vector>
+
+constexpr auto shard_builder = [](std::size_t shard) -> std::vector<int>
+{
+    std::vector<int> result;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        result.push_back(static_cast<int>(shard) * 100 + i);
+    }
+
+    return result;
+};
+
+// Shards are frozen in sharded_0.cpp and sharded_1.cpp
+extern const std::span<const int> sorted_shard_0;
+extern const std::span<const int> sorted_shard_1;
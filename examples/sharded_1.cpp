@@ -0,0 +1,5 @@
+#include "sharded.h"
+
+constexpr static auto constexpr_shard = cant::too_constexpr<std::size_t { 1 }>(shard_builder);
+
+extern constinit const std::span<const int> sorted_shard_1 = constexpr_shard;
@@ -0,0 +1,94 @@
+#include "cant.h"
+
+#include <string>
+#include <vector>
+
+constexpr auto names_initializer = []() -> std::vector<std::string>
+{
+    std::vector<std::string> result;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        result.push_back(std::string(32, static_cast<char>('a' + i)));
+    }
+
+    return result;
+};
+
+constexpr auto names_stats = cant::stats(names_initializer);
+
+// Costs of freezing can be limited in CI
+static_assert(names_stats.levels == 2 && names_stats.counted_containers == 11, "error");
+static_assert(names_stats.counted_allocations == names_stats.allocations, "error");
+static_assert(names_stats.allocations == 1 && names_stats.transient_allocations == 0, "error");
+static_assert(names_stats.payload_objects == 10, "error");
+static_assert(names_stats.replay_lookup_steps <= 10, "error");
+
+constexpr static auto constexpr_names = cant::too_constexpr(names_initializer);
+
+constexpr auto names_footprint = cant::footprint(constexpr_names);
+
+// All strings are stored in frozen vector, every one of them and vector refer to their storages by pointers
+static_assert(names_footprint.payload_bytes == 10 * 32, "error");
+static_assert(names_footprint.total_bytes == sizeof(constexpr_names), "error");
+static_assert(names_footprint.pointers == 3 + 10, "error");
+
+constexpr std::size_t GrowthAllocationsNum = 10000;
+
+/**
+ * @brief Steps of search of pointers in script of buffer, which grows GrowthAllocationsNum times
+ * @details Growing buffer allocates new block and releases previous one, so only two entries are alived
+ *          and every search takes one step
+ */
+constexpr std::size_t growth_lookup_steps()
+{
+    cant::alloc_script_t<GrowthAllocationsNum, true> script;
+    int blocks[GrowthAllocationsNum] {};
+
+    for (std::size_t i = 0; i < GrowthAllocationsNum; ++i)
+    {
+        script.add_entry({ .ptr = &blocks[i], .num = 1, .allocator_id = cant::MonotonicId::first() });
+        if (i > 0)
+        {
+            script.mark_as_deallocated(&blocks[i - 1]);
+        }
+    }
+
+    return script.counters.lookup_steps;
+}
+
+// Scan of all entries from the first one took GrowthAllocationsNum^2 / 2 steps
+static_assert(growth_lookup_steps() == GrowthAllocationsNum - 1, "error");
+
+/**
+ * @brief Steps of search of pointers in script, which allocates Num blocks and then releases them
+ * @param first_released Index of the first released block, blocks are released in order of allocation starting from it,
+ *        then blocks before it are released in order of allocation
+ */
+template<std::size_t Num>
+constexpr std::size_t release_lookup_steps(std::size_t first_released)
+{
+    cant::alloc_script_t<Num, true> script;
+    int blocks[Num] {};
+
+    for (std::size_t i = 0; i < Num; ++i)
+    {
+        script.add_entry({ .ptr = &blocks[i], .num = 1, .allocator_id = cant::MonotonicId::first() });
+    }
+    for (std::size_t i = 0; i < Num; ++i)
+    {
+        script.mark_as_deallocated(&blocks[(first_released + i) % Num]);
+    }
+
+    return script.counters.lookup_steps;
+}
+
+// Blocks released in order of allocation (e.g. nodes of list) are found at the oldest end of alived entries
+static_assert(release_lookup_steps<GrowthAllocationsNum>(0) == GrowthAllocationsNum, "error");
+
+constexpr std::size_t MiddleAllocationsNum = 500;
+
+// Lookup isn't constant: block in the middle of k alived entries takes k / 2 steps, so releasing of the second half of
+// blocks before the first one takes quadratic number of steps
+static_assert(release_lookup_steps<MiddleAllocationsNum>(MiddleAllocationsNum / 2)
+              == (MiddleAllocationsNum / 2) * (MiddleAllocationsNum / 2 + 1) / 2 + MiddleAllocationsNum / 2, "error");
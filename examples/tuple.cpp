@@ -0,0 +1,43 @@
+#include "cant.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+constexpr static auto constexpr_table =
+    cant::too_constexpr(
+        []() -> std::tuple<std::vector<int>, std::vector<int>, std::string>
+        {
+            std::vector<int> keys;
+            std::vector<int> values;
+            std::string names;
+
+            for (int i = 0; i < 5; ++i)
+            {
+                keys.push_back(i);
+                values.push_back(i * i);
+                names += static_cast<char>('a' + i);
+            }
+
+            return { keys, values, names };
+        }
+    );
+
+static_assert(std::tuple_size_v<decltype(constexpr_table)> == 3, "error");
+static_assert(constexpr_table.get<0>()[4] == 4, "error");
+static_assert(constexpr_table.get<1>()[4] == 16, "error");
+static_assert(constexpr_table.get<2>() == "abcde", "error");
+
+constexpr int sum_values()
+{
+    const auto& [keys, values, names] = constexpr_table;
+
+    int result = 0;
+    for (auto value : values)
+    {
+        result += value;
+    }
+    return result;
+}
+
+static_assert(sum_values() == 30, "error");
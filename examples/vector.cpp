@@ -28,3 +28,69 @@ static_assert(
     >,
     "type of constexpr_vector is not std::vector specialization"
 );
+
+// Sealed allocator keeps only null pointer to replay context and number of objects in its storage
+static_assert(magic_vector_allocator_t::overhead() == sizeof(void*) + sizeof(std::size_t), "Allocator keeps state besides payload");
+static_assert(
+    sizeof(constexpr_vector) == sizeof(std::vector<int>) + 10 * sizeof(int) + sizeof(void*) + sizeof(std::size_t),
+    "Result is bigger than container with its payload"
+);
+
+// Initializer grows vector by push_back, frozen vector keeps neither its growth slack nor storage for it
+constexpr static auto constexpr_grown_vector =
+    cant::too_constexpr(
+        []() -> std::vector<int>
+        {
+            std::vector<int> result;
+            for (int i = 0; i < 100; ++i)
+            {
+                result.push_back(i);
+            }
+            return result;
+        }
+    );
+
+static_assert(constexpr_grown_vector.size() == 100 && constexpr_grown_vector.capacity() == 100, "Growth slack of initializer is frozen");
+static_assert(
+    decltype(constexpr_grown_vector)::allocator_type::storage_bytes() == 100 * sizeof(int),
+    "Static storage contains more than values of frozen vector"
+);
+
+struct record_t
+{
+    constexpr record_t(int key, int value)
+        : key(key)
+        , value(value)
+    {}
+
+    int key;
+    int value;
+};
+
+static_assert(!std::is_default_constructible_v<record_t>, "record_t must not be default constructible");
+
+// Storage of records isn't default constructed, records are constructed only by vector
+constexpr static auto constexpr_records =
+    cant::too_constexpr(
+        []() -> std::vector<record_t>
+        {
+            std::vector<record_t> result;
+            for (int i = 0; i < 5; ++i)
+            {
+                result.emplace_back(i, i * i);
+            }
+            return result;
+        }
+    );
+
+static_assert(constexpr_records.size() == 5 && constexpr_records[4].value == 16, "error");
+static_assert(constexpr_records.capacity() == constexpr_records.size(), "Growth slack of initializer is frozen");
+
+constexpr static auto constexpr_squares = cant::generate<1000>([](std::size_t i) { return static_cast<int>(i * i); });
+
+static_assert(constexpr_squares.size() == 1000 && constexpr_squares.capacity() == 1000, "error");
+static_assert(constexpr_squares[999] == 998001, "error");
+
+constexpr static auto constexpr_generated_records = cant::generate<100>([](std::size_t i) { return record_t(static_cast<int>(i), 1); });
+
+static_assert(constexpr_generated_records.size() == 100 && constexpr_generated_records[99].key == 99, "error");
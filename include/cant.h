@@ -5,10 +5,13 @@
 #include <new>
 #include <tuple>
 #include <algorithm>
-#include <typeinfo>
+#include <array>
 #include <memory>
 #include <utility>
 #include <type_traits>
+#include <functional>
+#include <span>
+#include <vector>
 
 namespace cant
 {
@@ -50,23 +53,35 @@ namespace cant
         constexpr std::strong_ordering operator<=>(const MonotonicId& other) const = default;
     };
 
+    using type_id_t = const void*;
+
+    template<typename T>
+    struct type_tag_t
+    {
+        static constexpr char id {};
+    };
+
+    /**
+     * @brief Constexpr type identity
+     * @details Addresses of distinct objects can be compared for equality in constant evaluation
+     *          and can be used as template arguments, unlike std::type_info
+     */
+    template<typename T>
+    constexpr type_id_t type_id()
+    {
+        return &type_tag_t<T>::id;
+    }
+
     template<std::size_t Capacity>
     struct alived_counts_t
     {
         template<typename T>
         constexpr std::size_t alived() const
         {
-            for (std::size_t i = 0; i < count; ++i)
-            {
-                if (values[i].object_size == sizeof(T))
-                {
-                    return values[i].alived_count;
-                }
-            }
-            return 0;
+            return alived_by_id(type_id<T>());
         }
 
-        constexpr void add(std::size_t object_size, std::size_t num)
+        constexpr void add(type_id_t object_type, std::size_t object_size, std::size_t num)
         {
             auto actualEnd = std::begin(values) + count;
             auto it = std::find_if(
@@ -74,41 +89,126 @@ namespace cant
                     actualEnd,
                     [&](auto entry)
                     {
-                        return entry.object_size == object_size;
+                        return entry.object_type == object_type;
                     });
             it->alived_count += num;
             if (it == actualEnd)
             {
+                it->object_type = object_type;
                 it->object_size = object_size;
                 count++;
             }
         }
 
+        constexpr void remove(type_id_t object_type, std::size_t num)
+        {
+            auto actualEnd = std::begin(values) + count;
+            auto it = std::find_if(
+                    std::begin(values),
+                    actualEnd,
+                    [&](auto entry)
+                    {
+                        return entry.object_type == object_type;
+                    });
+            if (it != actualEnd)
+            {
+                it->alived_count -= num;
+            }
+        }
+
+        constexpr void merge(const alived_counts_t& other)
+        {
+            for (std::size_t i = 0; i < other.count; ++i)
+            {
+                auto num = other.values[i].alived_count;
+                auto current = alived_by_id(other.values[i].object_type);
+                if (num > current)
+                {
+                    add(other.values[i].object_type, other.values[i].object_size, num - current);
+                }
+            }
+        }
+
+        /**
+         * @brief Adds counts of all types of other
+         */
+        constexpr void add(const alived_counts_t& other)
+        {
+            for (std::size_t i = 0; i < other.count; ++i)
+            {
+                add(other.values[i].object_type, other.values[i].object_size, other.values[i].alived_count);
+            }
+        }
+
+        constexpr std::size_t alived_by_id(type_id_t object_type) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (values[i].object_type == object_type)
+                {
+                    return values[i].alived_count;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * @return Bytes of static storages of all types
+         */
+        constexpr std::size_t storage_bytes() const
+        {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                result += values[i].object_size * values[i].alived_count;
+            }
+            return result;
+        }
+
         struct
         {
+            type_id_t object_type {};
             std::size_t object_size {};
             std::size_t alived_count {};
         } values[Capacity + 1] {};
         std::size_t count {};
     };
 
-    struct script_entry_t
+    inline constexpr std::size_t ObjectTypesMaxNum = 16;
+
+    struct allocations_count_t
     {
-    private:
-        struct DummyTypeId{};
+        /**
+         * @brief Adds counts of one more container of level
+         * @details Maximal counts are kept, so capacities are enough for every container of level.
+         *          Alived objects of all containers are summed up for pool shared by containers of level
+         */
+        constexpr void merge(const allocations_count_t& other)
+        {
+            allocations_num = std::max(allocations_num, other.allocations_num);
+            alived.merge(other.alived);
+            total_alived.add(other.alived);
+        }
 
-    public:
+        std::size_t allocations_num {};
+        alived_counts_t<ObjectTypesMaxNum> alived;
+        alived_counts_t<ObjectTypesMaxNum> total_alived;
+    };
+
+    struct script_entry_t
+    {
         void* ptr {};
         std::size_t num {};
-        std::size_t object_size {};
         MonotonicId allocator_id;
 
-        bool lastForThisAllocator {};
         bool deallocated {};
 
-        std::reference_wrapper<const std::type_info> object_type {typeid(DummyTypeId)};
+        /**
+         * @brief Dense index of allocator_id among allocators of finalized script
+         */
+        std::size_t allocator_index {};
 
-        std::size_t level {};
+        type_id_t object_type {};
 
         constexpr friend bool operator==(const script_entry_t&, const script_entry_t&);
     };
@@ -116,56 +216,29 @@ namespace cant
     constexpr bool operator==(const script_entry_t& lhs, const script_entry_t& rhs)
     {
         return
-                std::tie(lhs.ptr, lhs.num, lhs.object_size, lhs.object_type.get(), lhs.allocator_id, lhs.lastForThisAllocator, lhs.deallocated) ==
-                std::tie(rhs.ptr, rhs.num, rhs.object_size, rhs.object_type.get(), rhs.allocator_id, rhs.lastForThisAllocator, rhs.deallocated);
+                std::tie(lhs.ptr, lhs.num, lhs.object_type, lhs.allocator_id, lhs.deallocated) ==
+                std::tie(rhs.ptr, rhs.num, rhs.object_type, rhs.allocator_id, rhs.deallocated);
     }
 
-    constexpr std::size_t LevelsMaxNum = 16;
-
-    struct script_capacities_t
-    {
-        constexpr std::size_t& operator[](std::size_t index)
-        {
-            return values[index];
-        }
-        constexpr const std::size_t& operator[](std::size_t index) const
-        {
-            return values[index];
-        }
-
-        std::size_t values[LevelsMaxNum]{};
-    };
+    inline constexpr std::size_t LevelsMaxNum = 16;
 
-    template<std::size_t LevelsNum, auto Capacities>
-    struct script_entries_holder_t
-    {
-        constexpr std::size_t& operator[](std::size_t index)
-        {
-            return values[index];
-        }
-        constexpr const std::size_t& operator[](std::size_t index) const
-        {
-            return values[index];
-        }
-        script_entry_t values[Capacities[LevelsNum - 1]]{};
-        script_entries_holder_t<LevelsNum - 1, Capacities> nested;
-    };
+    /**
+     * @brief Operations counters of allocations script, they are kept only by scripts of cant::stats
+     */
+    template<bool Enabled>
+    struct script_counters_t
+    {};
 
-    template<auto Capacities>
-    struct script_entries_holder_t<0, Capacities>
+    template<>
+    struct script_counters_t<true>
     {
-        constexpr std::size_t& operator[](std::size_t index)
-        {
-            return values[index];
-        }
-        constexpr const std::size_t& operator[](std::size_t index) const
-        {
-            return values[index];
-        }
-        script_entry_t values[Capacities[0]];
+        // Steps of search of pointers
+        std::size_t lookup_steps {};
+        // Checks of end of script for allocator
+        std::size_t finished_checks {};
     };
 
-    template<std::size_t Capacity>
+    template<std::size_t Capacity, bool CountOperations = false>
     struct alloc_script_t
     {
         constexpr alloc_script_t() = default;
@@ -173,83 +246,89 @@ namespace cant
         constexpr alloc_script_t(const alloc_script_t& rhs)
                 : _size(rhs._size)
                 , next_consumer_id(rhs.next_consumer_id)
+                , counters(rhs.counters)
+                , first_alived(rhs.first_alived)
+                , last_alived(rhs.last_alived)
         {
             std::copy(rhs.begin(), rhs.end(), begin());
+            std::copy(std::begin(rhs.events_num), std::begin(rhs.events_num) + _size, std::begin(events_num));
+            std::copy(std::begin(rhs.prev_alived), std::begin(rhs.prev_alived) + _size, std::begin(prev_alived));
+            std::copy(std::begin(rhs.next_alived), std::begin(rhs.next_alived) + _size, std::begin(next_alived));
         }
 
         constexpr script_entry_t* add_entry(script_entry_t new_entry)
         {
             entries[_size] = new_entry;
             _size += 1;
-            return &entries[_size - 1];
-        }
-
-        constexpr alloc_script_t& operator+=(const alloc_script_t& other)
-        {
-            for (const auto& i : other)
-            {
-                auto id_offset = next_consumer_id.raw();
-                auto entry = i;
-                entry.allocator_id = MonotonicId(id_offset + i.allocator_id.raw());
-
-                add_entry(entry);
-            }
-            next_consumer_id = MonotonicId(next_consumer_id.raw() + other.next_consumer_id.raw() + 1);
-            return *this;
-        }
-
-        constexpr alloc_script_t get_subscript(std::size_t offset) const
-        {
-            alloc_script_t result;
-            auto level = entries[offset].level;
-            auto sameLevelLastEntry = std::find_if(begin() + offset, end(), [level](const script_entry_t& entry){ return entry.level != level; });
 
-            for (auto it = begin() + offset; it != sameLevelLastEntry; ++it)
+            auto index = static_cast<int>(_size - 1);
+            if (new_entry.ptr)
             {
-                result.add_entry(*it);
+                prev_alived[index] = last_alived;
+                next_alived[index] = -1;
+                if (last_alived != -1)
+                {
+                    next_alived[last_alived] = index;
+                }
+                else
+                {
+                    first_alived = index;
+                }
+                last_alived = index;
             }
 
-            return result;
+            return &entries[index];
         }
 
+        /**
+         * @return Deallocated entry or nullptr, if ptr wasn't allocated by this script
+         */
         constexpr script_entry_t* mark_as_deallocated(void* ptr)
         {
-            auto it =
-                    std::find_if(begin(), end(),
-                                 [&](const script_entry_t& e)
-                                 {
-                                     return e.ptr == ptr;
-                                 });
+            auto index = get_index(ptr);
+            if (index == -1)
+            {
+                return nullptr;
+            }
 
-            it->ptr = nullptr;
-            it->deallocated = true;
+            unlink_alived(index);
 
-            return it;
-        }
+            entries[index].ptr = nullptr;
+            entries[index].deallocated = true;
 
-        constexpr void set_level(std::size_t level)
-        {
-            for (auto &entry : *this)
-            {
-                entry.level = level;
-            }
+            return &entries[index];
         }
 
+        /**
+         * @details Gives dense indexes to allocators and counts events (allocations and deallocations)
+         *          expected for every allocator, so replay can detect end of script for allocator in O(1)
+         */
         constexpr void finalize()
         {
-            auto id_founded = new bool[next_consumer_id.raw()]{};
+            // Last taken id is next_id() itself
+            auto ids_num = next_consumer_id.raw() + 1;
+            auto id_founded = new bool[ids_num]{};
+            auto allocator_indexes = new std::size_t[ids_num]{};
+            std::size_t allocators_num = 0;
+
+            std::fill(std::begin(events_num), std::end(events_num), 0);
 
             for (int i = (_size - 1); i >= 0; --i)
             {
                 auto id = entries[i].allocator_id.raw();
                 if (!id_founded[id])
                 {
-                    entries[i].lastForThisAllocator = true;
                     id_founded[id] = true;
+                    allocator_indexes[id] = allocators_num++;
                 }
+                entries[i].allocator_index = allocator_indexes[id];
+                events_num[entries[i].allocator_index] += entries[i].deallocated ? 2 : 1;
                 entries[i].ptr = nullptr;
             }
+            first_alived = -1;
+            last_alived = -1;
 
+            delete[] allocator_indexes;
             delete[] id_founded;
         }
 
@@ -258,104 +337,71 @@ namespace cant
             return _size;
         }
 
-        constexpr int get_index(void* ptr) const
+        /**
+         * @details Pointers can be compared only for equality in constant evaluation, so they can't be hashed
+         *          or ordered. Instead only alived entries are searched from both ends, so lookup takes
+         *          O(min(newer, older alived entries)) steps. Memory released right after allocation (e.g. previous
+         *          buffer of growing vector) or in order of allocation (e.g. nodes released before buckets)
+         *          is found in few steps, but releases from the middle cost O(alived) steps each.
+         */
+        constexpr int get_index(void* ptr)
         {
-            for (std::size_t i = 0; i < _size; ++i)
+            if (ptr == nullptr)
             {
-                if (entries[i].ptr == ptr)
-                {
-                    return i;
-                }
+                return -1;
             }
-            return -1;
-        }
-
-        constexpr script_entry_t get_info(std::size_t index) const
-        {
-            auto entry = entries[index];
-            entry.ptr = nullptr;
-            return entry;
-        }
-
-        constexpr alived_counts_t<Capacity> alived_counts() const
-        {
-            alived_counts_t<Capacity> result;
 
-            auto level = entries[0].level;
-            for (const auto& entry : *this)
+            for (int newer = last_alived, older = first_alived; newer != -1; newer = prev_alived[newer], older = next_alived[older])
             {
-                if (entry.level != level)
+                if constexpr (CountOperations)
                 {
-                    break;
+                    ++counters.lookup_steps;
                 }
-                result.add(entry.object_size, entry.deallocated ? 0 : entry.num);
-            }
-
-            return result;
-        }
-
-        constexpr bool all_deallocated(const alloc_script_t& ethalone) const
-        {
-            for (std::size_t i = 0; i < ethalone._size; ++i)
-            {
-                if (ethalone.entries[i].deallocated && !entries[i].deallocated)
+                if (entries[newer].ptr == ptr)
                 {
-                    return false;
+                    return newer;
                 }
-            }
-
-            return true;
-        };
-
-        constexpr bool all_finished(const alloc_script_t& ethalone) const
-        {
-            return _size == ethalone._size && all_deallocated(ethalone);
-        }
-
-        constexpr bool finished(const alloc_script_t& ethalone, std::size_t object_size) const
-        {
-            int last = ethalone._size;
-            for (int i = ethalone._size - 1; i >= 0; --i)
-            {
-                if (ethalone.entries[i].object_size == object_size)
+                if (older == newer)
                 {
-                    last = i;
                     break;
                 }
-            }
-
-            bool all_deallocated = true;
-            for (std::size_t i = 0; i < ethalone._size; ++i)
-            {
-                if (entries[i].object_size == object_size && ethalone.entries[i].deallocated && !entries[i].deallocated)
+                if (entries[older].ptr == ptr)
+                {
+                    return older;
+                }
+                if (next_alived[older] == newer)
                 {
-                    all_deallocated = false;
                     break;
                 }
             }
+            return -1;
+        }
 
-            return _size >= last && all_deallocated;
+        constexpr script_entry_t get_info(std::size_t index) const
+        {
+            auto entry = entries[index];
+            entry.ptr = nullptr;
+            return entry;
+        }
+
+        /**
+         * @brief Counts allocation or deallocation made by allocator during replay
+         */
+        constexpr void add_event(std::size_t allocator_index)
+        {
+            events_num[allocator_index] += 1;
         }
 
-        constexpr bool finished_for_id(const alloc_script_t& ethalone, MonotonicId id) const
+        /**
+         * @return true, if all events expected by ethalone script for allocator are already replayed
+         */
+        constexpr bool finished_for_id(const alloc_script_t& ethalone, std::size_t allocator_index)
         {
-            bool finished = true;
-            for (std::size_t i = 0; i < ethalone._size; ++i)
+            if constexpr (CountOperations)
             {
-                if (ethalone.entries[i].allocator_id == id)
-                {
-                    if (_size < i)
-                    {
-                        return false;
-                    }
-                    if (ethalone.entries[i].deallocated && !entries[i].deallocated)
-                    {
-                        return false;
-                    }
-                }
+                ++counters.finished_checks;
             }
-
-            return true;
+            return events_num[allocator_index] == ethalone.events_num[allocator_index];
         }
 
         constexpr ~alloc_script_t() = default;
@@ -385,181 +431,377 @@ namespace cant
             next_consumer_id = MonotonicId::next(next_consumer_id);
         }
 
+        /**
+         * @return New id for copy of allocator
+         */
+        constexpr MonotonicId acquire_id()
+        {
+            move_id();
+            return next_id();
+        }
+
         constexpr MonotonicId next_id() const
         {
             return next_consumer_id;
         }
 
-        using root_allocator_type = std::allocator<int>;
+        script_entry_t entries[Capacity + 1];
+        std::size_t _size {};
+
+        MonotonicId next_consumer_id { MonotonicId::first() };
+
+        [[no_unique_address]] script_counters_t<CountOperations> counters;
 
-        template<typename T>
-        void register_allocator(T* allocator)
+    private:
+        constexpr void unlink_alived(int index)
         {
-            if constexpr (std::is_same_v<T, root_allocator_type>)
+            auto prev = prev_alived[index];
+            auto next = next_alived[index];
+
+            if (prev != -1)
             {
-                if (!root_allocator) {
-                    root_allocator = allocator;
-                }
+                next_alived[prev] = next;
+            }
+            else
+            {
+                first_alived = next;
+            }
+            if (next != -1)
+            {
+                prev_alived[next] = prev;
+            }
+            else
+            {
+                last_alived = prev;
             }
         }
 
-        script_entry_t entries[Capacity + 1];
-        std::size_t _size {};
+        /**
+         * @brief Doubly linked list of entries which are not deallocated yet, in order of allocation
+         */
+        int prev_alived[Capacity + 1] {};
+        int next_alived[Capacity + 1] {};
+        int first_alived { -1 };
+        int last_alived { -1 };
 
-        MonotonicId next_consumer_id { MonotonicId::first() };
-        root_allocator_type* root_allocator {};
+        /**
+         * @brief Events number for every allocator: expected ones in finalized script, replayed ones otherwise
+         */
+        std::size_t events_num[Capacity + 1] {};
     };
 
     template<typename T>
     concept is_unordered = requires { typename T::hasher; };
 
-    template<typename Result, typename Init>
-    constexpr auto create_with_allocator(Init& init, [[maybe_unused]] const typename Result::allocator_type& allocator)
+    template<typename T>
+    concept is_map = requires { typename T::mapped_type; };
+
+    /**
+     * @brief Arguments of constructor of container from range of size elements with allocator
+     * @details Unordered containers reserve buckets for all elements up front, so they aren't rehashed during
+     *          construction and replay doesn't allocate and free intermediate bucket arrays
+     */
+    template<typename Result, typename Iterator>
+    constexpr auto constructor_args(Iterator first, Iterator last, std::size_t size, const typename Result::allocator_type& allocator)
     {
+        using allocator_type = typename Result::allocator_type;
+
         if constexpr (is_unordered<Result>)
         {
-            return Result { std::make_move_iterator(init.begin()), std::make_move_iterator(init.end()), 0, allocator };
+            return std::tuple<Iterator, Iterator, typename Result::size_type, const allocator_type&> { first, last, size, allocator };
         }
         else
         {
-            return Result { std::make_move_iterator(init.begin()), std::make_move_iterator(init.end()), allocator };
+            return std::tuple<Iterator, Iterator, const allocator_type&> { first, last, allocator };
         }
     }
 
-    template<typename T>
-    struct shared_value_t
+    /**
+     * @brief Iterator over elements of init, which are moved to new container
+     * @details Move of trivially copyable object is copy, so plain iterator is used for them: containers copy
+     *          trivially copyable elements as a block, unless allocator customizes construction
+     */
+    template<typename Init>
+    constexpr auto move_source_iterator([[maybe_unused]] Init& init, auto it)
     {
-        struct control_block_t
+        if constexpr (std::is_trivially_copyable_v<typename std::remove_const_t<Init>::value_type>)
         {
-            constexpr control_block_t(T* value)
-                    : counter(1)
-                    , value(value)
-            {}
+            return it;
+        }
+        else
+        {
+            return std::make_move_iterator(it);
+        }
+    }
 
-            constexpr T& operator*()
-            {
-                return *value;
-            }
+    /**
+     * @details Result is constructed from range of elements, not copied from init, so it doesn't keep growth slack
+     *          of init (e.g. capacity of vector filled by push_back): range constructor allocates exactly size
+     *          elements and static storage is sized by objects alived in result
+     */
+    template<typename Result, typename Init>
+    constexpr auto create_with_allocator(Init& init, const typename Result::allocator_type& allocator)
+    {
+        return std::make_from_tuple<Result>(
+                constructor_args<Result>(move_source_iterator(init, init.begin()), move_source_iterator(init, init.end()), init.size(), allocator));
+    }
 
-            constexpr const T& operator*() const
-            {
-                return *value;
-            }
+    /**
+     * @brief Constructs element of container in place from source element with factory
+     * @details Allocators construct object from builder by calling factory (other objects are constructed
+     *          by std::allocator_traits as usual), so nested containers are constructed
+     *          directly in storage of outer container and they are never moved (moved container would refer to
+     *          storage of moved-from allocator)
+     */
+    template<typename Source, typename Factory>
+    struct element_builder_t
+    {
+        template<typename T>
+        constexpr void construct(T* ptr) const
+        {
+            factory(ptr, *source);
+        }
 
-            std::size_t counter{};
-            T* value;
-        };
+        Source* source;
+        Factory factory;
+    };
 
-        constexpr shared_value_t()
-                : value(new control_block_t{new T()})
-        {}
+    template<typename T>
+    struct is_element_builder : std::false_type {};
 
-        constexpr shared_value_t(const shared_value_t& other)
-                : value(other.value)
-        {
-            if (value)
-            {
-                if constexpr (requires { T().move_id(); })
-                {
-                    value->value->move_id();
-                }
-                value->counter++;
-            }
-        }
+    template<typename Source, typename Factory>
+    struct is_element_builder<element_builder_t<Source, Factory>> : std::true_type {};
 
-        constexpr shared_value_t(shared_value_t&& other)
-                : value(other.value)
+    template<typename Iterator, typename Factory>
+    struct element_builder_iterator_t
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = element_builder_t<std::remove_reference_t<decltype(*std::declval<Iterator>())>, Factory>;
+        using pointer = void;
+        using reference = value_type;
+
+        constexpr reference operator*() const
         {
-            other.value = nullptr;
+            return { &*it, factory };
         }
 
-        constexpr shared_value_t& operator=(const shared_value_t& other)
+        constexpr element_builder_iterator_t& operator++()
         {
-            reset();
-            value = other.value;
-            if (value)
-            {
-                if constexpr (requires { T().move_id(); })
-                {
-                    value->value->move_id();
-                }
-                value->counter++;
-            }
+            ++it;
             return *this;
         }
 
-        constexpr void reset()
+        constexpr element_builder_iterator_t operator++(int)
         {
-            if (value)
-            {
-                value->counter -= 1;
-                if (!(value->counter))
-                {
-                    delete value->value;
-                    delete value;
-                }
-                value = nullptr;
-            }
+            auto result = *this;
+            ++it;
+            return result;
         }
 
-        constexpr ~shared_value_t()
+        constexpr friend bool operator==(const element_builder_iterator_t& lhs, const element_builder_iterator_t& rhs)
         {
-            reset();
+            return lhs.it == rhs.it;
         }
 
-        constexpr T& operator*()
-        {
-            return *value->value;
-        }
+        Iterator it;
+        Factory factory {};
+    };
+
+    /**
+     * @brief Creates container, which elements are constructed in place by Factory from elements of init
+     */
+    template<typename Result, typename Factory, typename Init>
+    constexpr auto create_with_allocator(Init& init, const typename Result::allocator_type& allocator)
+    {
+        using iterator = element_builder_iterator_t<decltype(init.begin()), Factory>;
 
-        constexpr const T& operator*() const
+        return std::make_from_tuple<Result>(
+                constructor_args<Result>(iterator { init.begin() }, iterator { init.end() }, init.size(), allocator));
+    }
+
+    /**
+     * @brief Array of default constructible and trivially destructible objects
+     * @details Containers construct objects over value initialized elements, constant evaluation
+     *          of all compilers supports it. Value initialization of trivial objects doesn't cost constexpr steps
+     */
+    template<typename T, std::size_t Capacity>
+    struct value_initialized_array_t
+    {
+        constexpr T* data()
         {
-            return *value->value;
+            return values;
         }
 
-        constexpr T* operator->()
+        constexpr const T* data() const
         {
-            return value->value;
+            return values;
         }
 
-        constexpr const T* operator->() const
+        template<typename... Args>
+        constexpr void construct(T* ptr, Args&&... args)
         {
-            return value->value;
+            std::construct_at(ptr, std::forward<Args>(args)...);
         }
 
-        constexpr operator bool() const
+        T values[Capacity] {};
+    };
+
+    /**
+     * @brief Array of default constructible objects, which are destroyed by container
+     * @details Destructor of union doesn't destroy elements, so they aren't destroyed twice. Elements are value
+     *          initialized, so member is active and containers construct objects over them
+     */
+    template<typename T, std::size_t Capacity>
+    union container_owned_array_t
+    {
+        constexpr container_owned_array_t()
+            : values {}
+        {}
+
+        constexpr ~container_owned_array_t() {}
+
+        constexpr T* data()
         {
-            return value;
+            return values;
         }
 
-        control_block_t* value;
+        constexpr const T* data() const
+        {
+            return values;
+        }
+
+        template<typename... Args>
+        constexpr void construct(T* ptr, Args&&... args)
+        {
+            std::construct_at(ptr, std::forward<Args>(args)...);
+        }
+
+        T values[Capacity];
     };
 
+    /**
+     * @brief Uninitialized array of objects without default constructor, which are constructed by container
+     * @details Clang before C++26 doesn't allow to construct subobject of inactive union member in constant evaluation.
+     *          So objects are constructed in transient buffer, and array is activated at once by moving them into it,
+     *          when container constructs the last one. Container must construct every slot, it's so for storages
+     *          sized exactly by objects of result: storages of top level containers and of cant::generate.
+     *          At runtime objects are constructed in place.
+     */
     template<typename T, std::size_t Capacity>
-    struct stack_allocator_t
+    union buffered_array_t
     {
-        constexpr stack_allocator_t() = default;
-        constexpr stack_allocator_t(const stack_allocator_t& rhs)
+        struct pending_t
+        {
+            T* buffer {};
+            std::size_t constructed {};
+        };
+
+        struct array_t
+        {
+            template<std::size_t... Indexes>
+            constexpr array_t(T* buffer, std::index_sequence<Indexes...>)
+                : values { std::move(buffer[Indexes])... }
+            {}
+
+            T values[Capacity];
+        };
+
+        constexpr buffered_array_t()
+            : pending {}
+        {}
+
+        constexpr ~buffered_array_t() {}
+
+        constexpr T* data()
+        {
+            return array.values;
+        }
+
+        constexpr const T* data() const
         {
-            copy(rhs);
+            return array.values;
         }
 
-        constexpr stack_allocator_t(stack_allocator_t&& rhs)
+        template<typename... Args>
+        constexpr void construct(T* ptr, Args&&... args)
         {
-            copy(rhs);
+            if (!std::is_constant_evaluated())
+            {
+                std::construct_at(ptr, std::forward<Args>(args)...);
+                return;
+            }
+
+            if (!pending.buffer)
+            {
+                pending.buffer = std::allocator<T>().allocate(Capacity);
+            }
+            std::construct_at(pending.buffer + (ptr - array.values), std::forward<Args>(args)...);
+
+            if (++pending.constructed == Capacity)
+            {
+                auto* buffer = pending.buffer;
+                std::construct_at(&array, buffer, std::make_index_sequence<Capacity> {});
+                std::destroy(buffer, buffer + Capacity);
+                std::allocator<T>().deallocate(buffer, Capacity);
+            }
         }
 
+        pending_t pending;
+        array_t array;
+    };
+
+    template<typename T, std::size_t Capacity>
+    using stack_storage_t = std::conditional_t<
+            std::is_default_constructible_v<T>,
+            std::conditional_t<
+                    std::is_trivially_destructible_v<T>,
+                    value_initialized_array_t<T, Capacity>,
+                    container_owned_array_t<T, Capacity>>,
+            buffered_array_t<T, Capacity>>;
+
+    /**
+     * @brief Static storage of objects which are alived after construction of result
+     * @details Objects are placed contiguously in order of allocations script, so payload of allocator
+     *          is a single block which can be measured with data() and size()
+     */
+    template<typename T, std::size_t Capacity>
+    struct stack_allocator_t
+    {
+        using value_type = T;
+
+        constexpr stack_allocator_t() {}
+
+        /**
+         * @details Copy doesn't share storage, so it starts empty. Objects in storage belong to container,
+         *          which constructed them
+         */
+        constexpr stack_allocator_t([[maybe_unused]] const stack_allocator_t& rhs)
+        {}
+
+        constexpr stack_allocator_t([[maybe_unused]] stack_allocator_t&& rhs)
+        {}
+
         constexpr T* allocate(std::size_t n)
         {
             if (count + n > Capacity)
                 return nullptr;
 
-            auto result = &data[count];
+            auto result = storage.data() + count;
 
             count += n;
             return result;
         }
 
+        /**
+         * @brief Constructs object in storage, which was allocated by this allocator
+         */
+        template<typename... Args>
+        constexpr void construct(T* ptr, Args&&... args)
+        {
+            storage.construct(ptr, std::forward<Args>(args)...);
+        }
+
         /**
          *
          * @brief We can't deallocate static memory
@@ -568,22 +810,83 @@ namespace cant
         {
         }
 
-    private:
-        constexpr void copy(const stack_allocator_t& rhs)
+        constexpr const T* data() const
         {
-            count = rhs.count;
-            for (std::size_t i = 0; i < count; ++i)
-            {
-                std::construct_at(&data[i], rhs.data[i]);
-            }
+            return storage.data();
+        }
+
+        constexpr std::size_t size() const
+        {
+            return count;
+        }
+
+        static constexpr std::size_t capacity()
+        {
+            return Capacity;
         }
 
     private:
-        T data[Capacity];
+        stack_storage_t<T, Capacity> storage;
         std::size_t count {};
     };
 
-    template<typename T, typename AllocScriptType, auto AlivedCounts>
+    /**
+     * @brief Storage of allocator rebound to type, which objects aren't alived after construction of result
+     * @details It doesn't occupy any space in result except of empty object
+     */
+    template<typename T>
+    struct stack_allocator_t<T, 0>
+    {
+        using value_type = T;
+
+        constexpr T* allocate([[maybe_unused]] std::size_t n)
+        {
+            return nullptr;
+        }
+
+        constexpr void deallocate([[maybe_unused]] T* ptr, [[maybe_unused]] std::size_t n)
+        {
+        }
+
+        constexpr const T* data() const
+        {
+            return nullptr;
+        }
+
+        constexpr std::size_t size() const
+        {
+            return 0;
+        }
+
+        static constexpr std::size_t capacity()
+        {
+            return 0;
+        }
+    };
+
+    /**
+     * @brief Scripts replayed by allocators of frozen container
+     * @details Context is owned by caller and it's alived only during construction of result, so it isn't stored in result
+     */
+    template<typename AllocScript, typename Pool = void>
+    struct replay_context_t
+    {
+        using pool_type = Pool;
+
+        const AllocScript* ethalone_script {};
+        AllocScript* current_alloc_script {};
+        // Storage shared by all containers of nested level, containers of other levels have their own storages
+        Pool* pool {};
+    };
+
+    /**
+     * @brief Context of allocators of nested level, which aren't bound to frozen object (e.g. allocators of copies),
+     *        they allocate memory from heap, because pool belongs to frozen object
+     */
+    template<typename Context>
+    inline constexpr Context unbound_context {};
+
+    template<typename T, typename Context, auto AlivedCounts>
     struct script_allocator_t
     {
         using stack_allocator_type = stack_allocator_t<T, AlivedCounts.template alived<T>()>;
@@ -591,78 +894,99 @@ namespace cant
         template<class Other>
         struct rebind
         {
-            using other = script_allocator_t<Other, AllocScriptType, AlivedCounts> ;
+            using other = script_allocator_t<Other, Context, AlivedCounts> ;
         };
 
         using value_type = T;
 
-        constexpr script_allocator_t(AllocScriptType ethalone_script)
-            : current_alloc_script()
-            , id(current_alloc_script->next_id())
-            , ethalone_script(ethalone_script)
+        static constexpr bool pooled = !std::is_void_v<typename Context::pool_type>;
+
+        /**
+         * @brief Allocator which isn't bound to frozen object, e.g. of default initialized element of static storage
+         * @details Allocator of nested level allocates from heap, others are sealed and allocate from their own storage
+         */
+        constexpr script_allocator_t()
+            : context(pooled ? &unbound_context<Context> : nullptr)
+        {}
+
+        /**
+         * @details Allocator refers to replay context only during construction of result, so context must outlive
+         *          construction. Sealed allocator keeps only payload and null pointer to context
+         */
+        constexpr script_allocator_t(const Context& context)
+            : context(&context)
         {
-            if (ethalone_script.get_count() == 0)
+            if (context.ethalone_script->get_count() == 0)
             {
-                current_alloc_script.reset();
+                seal();
             }
         }
 
         constexpr script_allocator_t(const script_allocator_t& other)
-                : current_alloc_script(other.current_alloc_script)
+                : context(other.context)
                 , allocator(other.allocator)
-                , id(current_alloc_script ? current_alloc_script->next_id() : MonotonicId())
-                , ethalone_script(other.ethalone_script)
-        {}
-
-        template<typename Other>
-        constexpr script_allocator_t(const script_allocator_t<Other, AllocScriptType, AlivedCounts>& other)
-                : current_alloc_script(other.current_alloc_script)
-                , id(current_alloc_script ? current_alloc_script->next_id() : MonotonicId())
-                , ethalone_script(other.ethalone_script)
         {}
 
         template<typename Other>
-        constexpr script_allocator_t(script_allocator_t<Other, AllocScriptType, AlivedCounts>&& other)
-                : current_alloc_script(std::move(other.current_alloc_script))
-                , id(current_alloc_script ? current_alloc_script->next_id() : MonotonicId())
-                , ethalone_script(ethalone_script)
+        constexpr script_allocator_t(const script_allocator_t<Other, Context, AlivedCounts>& other)
+                : context(other.context)
         {}
 
-        constexpr script_allocator_t(script_allocator_t&& other)
-                : current_alloc_script(std::move(other.current_alloc_script))
-                , id(current_alloc_script ? current_alloc_script->next_id() : MonotonicId())
-                , ethalone_script(std::move(other.ethalone_script))
-        {}
+        /**
+         * @brief Allocator of copy of container
+         * @details Copy of nested container isn't bound to pool of frozen object. Other copies are sealed,
+         *          as copied allocator is, and allocate from their own storages
+         */
+        constexpr script_allocator_t select_on_container_copy_construction() const
+        {
+            if constexpr (pooled)
+            {
+                return script_allocator_t();
+            }
+            else
+            {
+                return *this;
+            }
+        }
 
         /**
-         * @details Control block is deleted in allocate() or deallocate(), becasue destructor will call in the end of programm
+         * @details Context is dropped in allocate() or deallocate(), becasue destructor will call in the end of programm
          */
         constexpr ~script_allocator_t() = default;
 
         constexpr T* allocate(std::size_t n)
         {
-            if (!current_alloc_script)
+            if (!context)
             {
                 return stack_allocator.allocate(n);
             }
 
-            if (current_alloc_script->get_count() >= ethalone_script.get_count())
+            if (!context->ethalone_script)
+            {
+                return allocator.allocate(n);
+            }
+
+            auto& current_alloc_script = *context->current_alloc_script;
+            const auto& ethalone_script = *context->ethalone_script;
+
+            if (current_alloc_script.get_count() >= ethalone_script.get_count())
                 return nullptr;
 
-            auto entry = ethalone_script.get_info(current_alloc_script->get_count());
+            auto entry = ethalone_script.get_info(current_alloc_script.get_count());
 
             if (entry.num != n)
                 return nullptr;
 
             T* result = entry.deallocated
                         ? allocator.allocate(n)
-                        : stack_allocator.allocate(n);
+                        : allocate_storage(n);
 
-            current_alloc_script->add_entry({result, n, sizeof(T), entry.allocator_id});
+            current_alloc_script.add_entry({ .ptr = result, .num = n, .allocator_id = entry.allocator_id, .object_type = type_id<T>() });
+            current_alloc_script.add_event(entry.allocator_index);
 
-            if (current_alloc_script->finished_for_id(ethalone_script, entry.allocator_id))
+            if (current_alloc_script.finished_for_id(ethalone_script, entry.allocator_index))
             {
-                current_alloc_script.reset();
+                seal();
             }
 
             return result;
@@ -670,48 +994,138 @@ namespace cant
 
         constexpr void deallocate(T* ptr, std::size_t n)
         {
-            if (current_alloc_script)
+            if (!context)
+            {
+                return;
+            }
+
+            if (!context->ethalone_script)
+            {
+                allocator.deallocate(ptr, n);
+                return;
+            }
+
+            auto& current_alloc_script = *context->current_alloc_script;
+            const auto& ethalone_script = *context->ethalone_script;
+
+            if (auto* deallocated = current_alloc_script.mark_as_deallocated(ptr))
             {
-                if (int index = current_alloc_script->get_index(ptr); index != -1)
+                auto entry = ethalone_script.get_info(deallocated - current_alloc_script.begin());
+                if (entry.deallocated)
                 {
-                    auto entry = ethalone_script.get_info(index);
-                    if (entry.deallocated)
-                    {
-                        allocator.deallocate(ptr, n);
-                    }
-                    current_alloc_script->mark_as_deallocated(ptr);
+                    allocator.deallocate(ptr, n);
+                    current_alloc_script.add_event(entry.allocator_index);
+                }
 
-                    if (current_alloc_script->finished_for_id(ethalone_script, entry.allocator_id))
-                    {
-                        current_alloc_script.reset();
-                    }
+                if (current_alloc_script.finished_for_id(ethalone_script, entry.allocator_index))
+                {
+                    seal();
+                }
+            }
+        }
+
+        template<typename U, typename Builder>
+                requires is_element_builder<std::remove_cvref_t<Builder>>::value
+        constexpr void construct(U* ptr, Builder&& builder)
+        {
+            builder.construct(ptr);
+        }
+
+        /**
+         * @details Sealed allocator allocates only from its own storage, so objects are constructed by storage
+         *          (storage of objects without default constructor buffers them in constant evaluation)
+         */
+        template<typename U, typename... Args>
+        constexpr void construct(U* ptr, Args&&... args)
+        {
+            if constexpr (std::is_same_v<U, T> && stack_allocator_type::capacity() > 0)
+            {
+                if (!context)
+                {
+                    stack_allocator.construct(ptr, std::forward<Args>(args)...);
+                    return;
                 }
             }
+            std::construct_at(ptr, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @return true, if allocator doesn't replay script anymore and keeps only payload
+         */
+        constexpr bool sealed() const
+        {
+            return !context || !context->ethalone_script;
+        }
+
+        /**
+         * @brief Size of allocator state besides payload storage
+         */
+        static constexpr std::size_t overhead()
+        {
+            return sizeof(script_allocator_t) - sizeof(T) * stack_allocator_type::capacity();
+        }
+
+        /**
+         * @brief Size of storages of all rebinds of allocator
+         */
+        static constexpr std::size_t storage_bytes()
+        {
+            return AlivedCounts.storage_bytes();
         }
 
-        shared_value_t<AllocScriptType> current_alloc_script;
-        AllocScriptType ethalone_script;
+        const Context* context {};
 
     private:
-        std::allocator<T> allocator;
-        stack_allocator_type stack_allocator;
+        /**
+         * @brief Drops reference to construction state, so only payload is left in result
+         */
+        constexpr void seal()
+        {
+            context = nullptr;
+        }
 
-        MonotonicId id;
+        /**
+         * @brief Storage of objects alived in result: pool of level for nested vectors and strings, own one otherwise
+         */
+        constexpr T* allocate_storage(std::size_t n)
+        {
+            if constexpr (!pooled)
+            {
+                return stack_allocator.allocate(n);
+            }
+            else if constexpr (std::is_same_v<T, typename Context::pool_type::value_type>)
+            {
+                return context->pool->allocate(n);
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        [[no_unique_address]] std::allocator<T> allocator;
+        [[no_unique_address]] stack_allocator_type stack_allocator;
     };
 
+    /**
+     * @details Counters are owned by caller, so copies and rebinds of allocator don't allocate anything
+     */
     template<typename T>
     struct counter_allocator_t
     {
         using value_type = T;
 
-        constexpr counter_allocator_t() = default;
+        constexpr counter_allocator_t(allocations_count_t& allocations_count)
+                : allocations_count(&allocations_count)
+        {}
+
         constexpr counter_allocator_t(const counter_allocator_t& other) = default;
         constexpr counter_allocator_t(counter_allocator_t&& other) = default;
         constexpr ~counter_allocator_t() = default;
 
         template<typename Other>
         constexpr counter_allocator_t(const counter_allocator_t<Other>& other)
-                : allocations_num(other.get_shared())
+                : allocations_count(&other.get_allocations_count())
         {}
 
         constexpr T* allocate(std::size_t n)
@@ -719,57 +1133,65 @@ namespace cant
             auto* res = allocator.allocate(n);
             if (res)
             {
-                *allocations_num += 1;
+                allocations_count->allocations_num += 1;
+                allocations_count->alived.add(type_id<T>(), sizeof(T), n);
             }
             return res;
         }
 
-        constexpr std::size_t get_allocations_num() const
+        template<typename U, typename Builder>
+                requires is_element_builder<std::remove_cvref_t<Builder>>::value
+        constexpr void construct(U* ptr, Builder&& builder)
         {
-            return *allocations_num;
+            builder.construct(ptr);
         }
 
-        constexpr void deallocate(T* ptr, std::size_t n)
+        constexpr allocations_count_t& get_allocations_count() const
         {
-            allocator.deallocate(ptr, n);
+            return *allocations_count;
         }
 
-        constexpr shared_value_t<std::size_t> get_shared() const
+        constexpr void deallocate(T* ptr, std::size_t n)
         {
-            return allocations_num;
+            allocator.deallocate(ptr, n);
+            allocations_count->alived.remove(type_id<T>(), n);
         }
 
     private:
-        shared_value_t<std::size_t> allocations_num;
-        std::allocator<T> allocator;
+        allocations_count_t* allocations_count;
+        [[no_unique_address]] std::allocator<T> allocator;
     };
 
+    /**
+     * @details Allocations script is owned by caller. Every copy or rebind of allocator takes next id from it.
+     */
     template<typename T, typename AllocScript>
     struct transcript_allocator_t
     {
         using value_type = T;
 
-        constexpr transcript_allocator_t()
-                : id(alloc_script->next_id())
+        constexpr transcript_allocator_t(AllocScript& alloc_script)
+                : alloc_script(&alloc_script)
+                , id(alloc_script.next_id())
         {}
 
         constexpr transcript_allocator_t(const transcript_allocator_t& other)
                 : alloc_script(other.alloc_script)
                 , allocator(other.allocator)
-                , id(alloc_script ? alloc_script->next_id() : MonotonicId())
+                , id(alloc_script->acquire_id())
         {}
         constexpr transcript_allocator_t(transcript_allocator_t&& other)
-                : alloc_script(std::move(other.alloc_script))
+                : alloc_script(other.alloc_script)
                 , allocator(std::move(other.allocator))
-                , id(alloc_script ? alloc_script->next_id() : MonotonicId())
+                , id(alloc_script->next_id())
         {}
 
         constexpr ~transcript_allocator_t() = default;
 
         template<typename Other>
         constexpr transcript_allocator_t(const transcript_allocator_t<Other, AllocScript>& other)
-                : alloc_script(other.get_shared())
-                , id(alloc_script->next_id())
+                : alloc_script(&other.get_alloc_script())
+                , id(alloc_script->acquire_id())
         {}
 
         constexpr T* allocate(std::size_t n)
@@ -777,33 +1199,42 @@ namespace cant
             auto* res = allocator.allocate(n);
             if (res)
             {
-                alloc_script->add_entry({ .ptr = res, .num = n, .object_size = sizeof(T), .allocator_id = id});
+                alloc_script->add_entry({ .ptr = res, .num = n, .allocator_id = id, .object_type = type_id<T>() });
             }
             return res;
         }
 
-        constexpr shared_value_t<AllocScript> get_alloc_script() const
+        template<typename U, typename Builder>
+                requires is_element_builder<std::remove_cvref_t<Builder>>::value
+        constexpr void construct(U* ptr, Builder&& builder)
         {
-            return alloc_script;
+            builder.construct(ptr);
         }
 
-        constexpr void deallocate(T* ptr, std::size_t n)
+        constexpr AllocScript& get_alloc_script() const
         {
-            allocator.deallocate(ptr, n);
-            alloc_script->mark_as_deallocated(ptr);
+            return *alloc_script;
         }
 
-        constexpr shared_value_t<AllocScript> const get_shared() const
+        constexpr void deallocate(T* ptr, std::size_t n)
         {
-            return alloc_script;
+            allocator.deallocate(ptr, n);
+            alloc_script->mark_as_deallocated(ptr);
         }
 
     private:
-        shared_value_t<AllocScript> alloc_script;
-        std::allocator<T> allocator;
+        AllocScript* alloc_script;
+        [[no_unique_address]] std::allocator<T> allocator;
         MonotonicId id;
     };
 
+    template<typename AllocScript>
+    struct transcript_allocator_of
+    {
+        template<typename T>
+        using type = transcript_allocator_t<T, AllocScript>;
+    };
+
     template <typename T>
     struct rebind_allocator;
 
@@ -886,116 +1317,1312 @@ namespace cant
     template<typename Initializer>
     using init_value_type = decltype(init_value<Initializer>());
 
+    /**
+     * @brief Element of container which can be container itself: mapped type of maps, value type otherwise
+     */
+    template<typename Container>
+    struct element_of
+    {
+        using type = typename Container::value_type;
+    };
+
     template<typename Container>
-    constexpr std::size_t count_allocations_impl(Container init)
+            requires is_map<Container>
+    struct element_of<Container>
     {
-        using ValueType = typename Container::value_type;
+        using type = typename Container::mapped_type;
+    };
+
+    template<typename Container>
+    using element_of_t = typename element_of<Container>::type;
 
-        std::size_t result = 0;
+    template<typename Container>
+    concept is_nested = has_allocator<element_of_t<Container>>;
 
-        if constexpr (has_allocator<ValueType>) // Вот это не надо наверное && !is_array_with_shared_allocator<Container>
+    template<typename Container, typename Value>
+    constexpr auto& element_value(Value& value)
+    {
+        if constexpr (is_map<Container>)
         {
-            for (const auto& value : init)
-            {
-                result += count_allocations_impl(value);
-            }
+            return value.second;
+        }
+        else
+        {
+            return value;
         }
+    }
 
-        using ContainerWithCounterAllocator =
-                typename rebind_allocator<Container>
-                ::template to<counter_allocator_t<ValueType>>;
+    template <typename Container, typename Element>
+    struct rebind_element;
 
-        auto container = create_with_allocator<ContainerWithCounterAllocator>(init, counter_allocator_t<ValueType>());
+    template <template<typename, typename> typename Container, typename T, typename Allocator, typename Element>
+    struct rebind_element<Container<T, Allocator>, Element> {
+        using value_type = Element;
 
-        auto allocator = container.get_allocator();
+        template <typename NewAllocator>
+        using to = Container<Element, NewAllocator>;
+    };
 
-        result += allocator.get_allocations_num();
+    template <template<typename, typename, typename, typename, typename> typename Container, typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename Element>
+    struct rebind_element<Container<Key, T, Hash, KeyEqual, Allocator>, Element> {
+        using value_type = std::pair<const Key, Element>;
 
-        return result;
-    }
+        template <typename NewAllocator>
+        using to = Container<Key, Element, Hash, KeyEqual, NewAllocator>;
+    };
 
-    template<typename Initializer>
-    constexpr std::size_t count_allocations()
-    {
-        auto init = init_value<Initializer>();
-        return count_allocations_impl(init);
-    }
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct frozen_level_t;
 
-    template<typename AllocScript>
-    struct get_alloc_script_result_t
+    /**
+     * @brief Container of level with allocator Allocator, nested containers are replaced by frozen containers of next level
+     */
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct level_container_t
     {
-        constexpr get_alloc_script_result_t(AllocScript alloc_script, bool dummy)
-                : alloc_script(alloc_script)
-                , dummy(dummy)
-        {}
+        using value_type = typename Container::value_type;
 
-        AllocScript alloc_script;
-        bool dummy;
+        template<template<typename> typename Allocator>
+        using with = rebind_allocator_to<Container, Allocator<value_type>>;
     };
 
-    template<std::size_t AllocationsNum, typename Container>
-    constexpr auto get_alloc_script_impl(Container init)
+    template<typename Initializer, typename Container, std::size_t Level>
+            requires is_nested<Container>
+    struct level_container_t<Initializer, Container, Level>
     {
-        using ValueType = typename Container::value_type;
+        static_assert(Level + 1 < LevelsMaxNum, "Too deep nesting of containers");
 
-        using allocator_t = transcript_allocator_t<ValueType, alloc_script_t<AllocationsNum>>;
-        alloc_script_t<AllocationsNum> result;
+        using element_type = typename frozen_level_t<Initializer, element_of_t<Container>, Level + 1>::type;
+        using value_type = typename rebind_element<Container, element_type>::value_type;
 
-        if constexpr (has_allocator<ValueType>)
-        {
-            for (const auto& value : init)
-            {
-                result += get_alloc_script_impl<AllocationsNum>(value);
-            }
-        }
-
-        using ContainerWithTranscriptAllocator =
-                typename rebind_allocator<Container>
-                ::template to<allocator_t>;
-
-        auto container = create_with_allocator<ContainerWithTranscriptAllocator>(init, allocator_t());
-
-        auto allocator = container.get_allocator();
-        auto alloc_script = allocator.get_alloc_script();
-        result += *alloc_script;
-        result.finalize();
-
-        return result;
-    }
+        template<template<typename> typename Allocator>
+        using with = typename rebind_element<Container, element_type>::template to<Allocator<value_type>>;
+    };
 
-    template<std::size_t AllocationsNum, typename Initializer>
-    constexpr auto get_alloc_script()
+    /**
+     * @brief Constructs element of nested container in place with constructor arguments of nested container
+     */
+    template<typename Container, typename T, typename Value, typename Args>
+    constexpr void construct_nested_element(T* ptr, Value& value, Args args)
     {
-        auto init = init_value<Initializer>();
-        return get_alloc_script_impl<AllocationsNum>(init);
+        if constexpr (is_map<Container>)
+        {
+            std::construct_at(ptr, std::piecewise_construct, std::forward_as_tuple(value.first), args);
+        }
+        else
+        {
+            std::apply([ptr](auto&&... args) { std::construct_at(ptr, std::forward<decltype(args)>(args)...); }, args);
+        }
     }
 
-    template<std::size_t level, typename AllocScriptType, auto AlivedCounts, typename Container>
-    constexpr auto too_constexpr_impl(Container init, AllocScriptType alloc_script)
+    /**
+     * @brief Constructs empty frozen element of next level
+     * @details Allocations of level don't depend on contents of nested containers, so counting and transcription
+     *          of level use empty elements
+     */
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct empty_element_factory_t
     {
-        using T = typename Container::value_type;
+        template<typename T, typename Value>
+        constexpr void operator()(T* ptr, Value& value) const
+        {
+            using element_level = frozen_level_t<Initializer, element_of_t<Container>, Level + 1>;
+            using element_allocator = typename element_level::type::allocator_type;
 
-        using ContainerWithScriptAllocator =
-                typename rebind_allocator<Container>
-                ::template to<script_allocator_t<T, AllocScriptType, AlivedCounts>>;
+            typename element_level::alloc_script_type empty_script;
+            typename element_level::alloc_script_type current_alloc_script;
+            typename element_level::context_type context { &empty_script, &current_alloc_script };
+            element_allocator allocator(context);
 
-        script_allocator_t<T, AllocScriptType, AlivedCounts> allocator(alloc_script);
+            construct_nested_element<Container>(ptr, value, std::tuple<const element_allocator&> { allocator });
+        }
+    };
 
-        return create_with_allocator<ContainerWithScriptAllocator>(init, allocator);
-    }
+    template<typename Initializer, std::size_t Level, typename Container, typename Pools, typename Construct>
+    constexpr auto construct_frozen(Container& init, Pools pools, Construct construct);
 
-    template<typename Initializer>
-    requires is_initializer<Initializer>
-    constexpr auto too_constexpr([[maybe_unused]] Initializer initalizer_labmda)
+    /**
+     * @brief Constructs frozen element of next level with its own allocations script
+     * @details Pools of nested levels are registered by frozen object before its elements are constructed,
+     *          so factory refers to pointer to them
+     */
+    template<typename Initializer, typename Container, std::size_t Level, typename Pools>
+    struct frozen_element_factory_t
     {
-        constexpr auto allocations_counts = count_allocations<Initializer>();
-        constexpr auto alloc_script = get_alloc_script<allocations_counts, Initializer>();
-        constexpr auto alived = alloc_script.alived_counts();
-
-        using alloc_script_type = std::remove_cv_t<decltype(alloc_script)>;
+        template<typename T, typename Value>
+        constexpr void operator()(T* ptr, Value& value) const
+        {
+            construct_frozen<Initializer, Level + 1>(element_value<Container>(value), pools, [ptr, &value](auto args)
+            {
+                construct_nested_element<Container>(ptr, value, args);
+            });
+        }
 
-        auto init = init_value<Initializer>();
+        Pools pools;
+    };
 
-        return too_constexpr_impl<0, alloc_script_type, alived>(init, alloc_script);
+    template<typename Result, typename Initializer, std::size_t Level, typename Container>
+    constexpr auto create_level(Container& init, const typename Result::allocator_type& allocator)
+    {
+        if constexpr (is_nested<Container>)
+        {
+            return create_with_allocator<Result, empty_element_factory_t<Initializer, std::remove_const_t<Container>, Level>>(init, allocator);
+        }
+        else
+        {
+            return create_with_allocator<Result>(init, allocator);
+        }
+    }
+
+    /**
+     * @brief Calls func for every container of level Level in init
+     */
+    template<std::size_t Level, typename Container, typename Func>
+    constexpr void for_each_on_level(Container& init, Func& func)
+    {
+        if constexpr (Level == 0)
+        {
+            func(init);
+        }
+        else
+        {
+            for (auto& value : init)
+            {
+                for_each_on_level<Level - 1>(element_value<Container>(value), func);
+            }
+        }
+    }
+
+    /**
+     * @brief Copies init into container with counting allocator
+     * @details Besides total number of allocations (capacity of allocations script) it collects
+     *          number of objects which are still alived after copying, so capacities of static storages
+     *          are known without transcription of allocations script. Nested containers are counted
+     *          on their own level, here they are replaced by empty ones.
+     */
+    template<typename Initializer, std::size_t Level, typename Container>
+    constexpr allocations_count_t count_allocations_impl(Container& init)
+    {
+        using ContainerWithCounterAllocator =
+                typename level_container_t<Initializer, Container, Level>
+                ::template with<counter_allocator_t>;
+
+        using ValueType = typename ContainerWithCounterAllocator::value_type;
+
+        allocations_count_t allocations_count;
+        auto container = create_level<ContainerWithCounterAllocator, Initializer, Level>(init, counter_allocator_t<ValueType>(allocations_count));
+
+        return allocations_count;
+    }
+
+    /**
+     * @return Maximal number of allocations and alived objects among containers of level
+     * @details Every container of level is copied once, containers of other levels aren't copied
+     */
+    template<typename Initializer, std::size_t Level = 0>
+    constexpr allocations_count_t count_allocations()
+    {
+        auto init = init_value<Initializer>();
+
+        allocations_count_t result;
+        auto count = [&result](auto& container)
+        {
+            result.merge(count_allocations_impl<Initializer, Level>(container));
+        };
+        for_each_on_level<Level>(init, count);
+
+        return result;
+    }
+
+    template<typename Initializer, std::size_t Level>
+    struct level_allocations_count
+    {
+        static constexpr allocations_count_t value = count_allocations<Initializer, Level>();
+    };
+
+    /**
+     * @brief Initializer of member of tuple returned by Initializer
+     */
+    template<typename Initializer, std::size_t Index>
+    struct member_initializer_t
+    {
+        constexpr auto operator()() const
+        {
+            return std::get<Index>(Initializer()());
+        }
+    };
+
+    template<typename T>
+    concept is_tuple_like = requires { std::tuple_size<T>::value; };
+
+    /**
+     * @brief Counts allocations of all members of tuple in one constant evaluation
+     */
+    template<typename Initializer>
+    constexpr auto count_members_allocations()
+    {
+        using tuple_type = init_value_type<Initializer>;
+
+        auto init = init_value<Initializer>();
+
+        std::array<allocations_count_t, std::tuple_size_v<tuple_type>> result;
+        [&]<std::size_t... Indexes>(std::index_sequence<Indexes...>)
+        {
+            ((result[Indexes] = count_allocations_impl<member_initializer_t<Initializer, Indexes>, 0>(std::get<Indexes>(init))), ...);
+        }(std::make_index_sequence<std::tuple_size_v<tuple_type>>{});
+
+        return result;
+    }
+
+    template<typename Initializer>
+    struct members_allocations_count
+    {
+        static constexpr auto value = count_members_allocations<Initializer>();
+    };
+
+    template<typename Initializer, std::size_t Index>
+    struct level_allocations_count<member_initializer_t<Initializer, Index>, 0>
+    {
+        static constexpr allocations_count_t value = members_allocations_count<Initializer>::value[Index];
+    };
+
+    /**
+     * @brief Initializer, which allocations scripts count their operations for cant::stats
+     */
+    template<typename Initializer>
+    struct counted_initializer_t
+    {
+        constexpr auto operator()() const
+        {
+            return Initializer()();
+        }
+    };
+
+    template<typename Initializer>
+    struct counts_operations : std::false_type {};
+
+    template<typename Initializer>
+    struct counts_operations<counted_initializer_t<Initializer>> : std::true_type {};
+
+    /**
+     * @brief Types of frozen container of level
+     * @details Capacities depend on all containers of level, so they are counted in separate constant evaluation
+     *          for every level.
+     *
+     *          Nested vectors and strings allocate only their values, so all containers of level share one pool
+     *          sized by sum of their objects, it is owned by frozen object. Nested unordered containers allocate
+     *          nodes and buckets, every one of them has its own storage sized by the biggest container of level.
+     */
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct frozen_level_t
+    {
+        static constexpr allocations_count_t allocations_count = level_allocations_count<Initializer, Level>::value;
+
+        static constexpr bool pooled = Level > 0 && std::contiguous_iterator<typename Container::iterator>;
+
+        using alloc_script_type = alloc_script_t<allocations_count.allocations_num, counts_operations<Initializer>::value>;
+
+        using value_type = typename level_container_t<Initializer, Container, Level>::value_type;
+
+        using pool_type = stack_allocator_t<value_type, pooled ? allocations_count.total_alived.template alived<value_type>() : 0>;
+
+        using context_type = replay_context_t<alloc_script_type, std::conditional_t<pooled, pool_type, void>>;
+
+        static constexpr auto storage_counts = pooled ? alived_counts_t<ObjectTypesMaxNum> {} : allocations_count.alived;
+
+        template<typename T>
+        using allocator_t = script_allocator_t<T, context_type, storage_counts>;
+
+        using type = typename level_container_t<Initializer, Container, Level>::template with<allocator_t>;
+    };
+
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct level_pools_t;
+
+    /**
+     * @brief Pools of levels nested into container of level
+     */
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct nested_pools_of
+    {
+        using type = std::tuple<>;
+    };
+
+    template<typename Initializer, typename Container, std::size_t Level>
+            requires is_nested<Container>
+    struct nested_pools_of<Initializer, Container, Level>
+    {
+        using type = level_pools_t<Initializer, element_of_t<Container>, Level + 1>;
+    };
+
+    /**
+     * @brief Pools of containers of level Level and of all deeper levels
+     */
+    template<typename Initializer, typename Container, std::size_t Level>
+    struct level_pools_t
+    {
+        using level = frozen_level_t<Initializer, Container, Level>;
+        using nested_pools_type = typename nested_pools_of<Initializer, Container, Level>::type;
+
+        constexpr level_pools_t() = default;
+
+        /**
+         * @brief Pools of frozen object register themselves before its container is constructed,
+         *        so nested containers are constructed in them
+         */
+        constexpr level_pools_t(level_pools_t*& self)
+        {
+            self = this;
+        }
+
+        template<std::size_t PoolLevel>
+        constexpr auto* pool()
+        {
+            if constexpr (PoolLevel == Level)
+            {
+                return &level_pool;
+            }
+            else
+            {
+                return nested_pools.template pool<PoolLevel>();
+            }
+        }
+
+        /**
+         * @brief Size of storages of pools of all levels
+         */
+        static constexpr std::size_t storage_bytes()
+        {
+            std::size_t result = sizeof(typename level::value_type) * level::pool_type::capacity();
+            if constexpr (is_nested<Container>)
+            {
+                result += nested_pools_type::storage_bytes();
+            }
+            return result;
+        }
+
+        [[no_unique_address]] typename level::pool_type level_pool;
+        [[no_unique_address]] nested_pools_type nested_pools;
+    };
+
+    /**
+     * @brief Frozen nested container, which owns pools of its nested levels
+     * @details Pools are constructed before container, so nested containers are constructed in them. Container is
+     *          constructed in place from its constructor arguments, because frozen container can't be moved
+     */
+    template<typename Pools, typename Container>
+    struct frozen_nested_t : Pools, Container
+    {
+        using pools_type = Pools;
+        using container_type = Container;
+
+        template<typename... Args>
+        constexpr frozen_nested_t(Pools*& pools, Args&&... args)
+            : Pools(pools)
+            , Container(std::forward<Args>(args)...)
+        {}
+    };
+
+    /**
+     * @brief Type of frozen object of container of level 0
+     */
+    template<typename Initializer, typename Container>
+    struct frozen_result_of
+    {
+        using type = typename frozen_level_t<Initializer, Container, 0>::type;
+    };
+
+    template<typename Initializer, typename Container>
+            requires is_nested<Container>
+    struct frozen_result_of<Initializer, Container>
+    {
+        using type = frozen_nested_t<
+                level_pools_t<Initializer, element_of_t<Container>, 1>,
+                typename frozen_level_t<Initializer, Container, 0>::type>;
+    };
+
+    template<typename Initializer, typename Container>
+    using frozen_result_t = typename frozen_result_of<Initializer, Container>::type;
+
+    /**
+     * @details init is copied (not moved), because same value is used later for construction of result
+     */
+    template<typename Initializer, std::size_t Level, typename Container>
+    constexpr auto get_alloc_script_impl(const Container& init)
+    {
+        using alloc_script_type = typename frozen_level_t<Initializer, Container, Level>::alloc_script_type;
+
+        using ContainerWithTranscriptAllocator =
+                typename level_container_t<Initializer, Container, Level>
+                ::template with<transcript_allocator_of<alloc_script_type>::template type>;
+
+        using allocator_t = typename ContainerWithTranscriptAllocator::allocator_type;
+
+        alloc_script_type alloc_script;
+        auto container = create_level<ContainerWithTranscriptAllocator, Initializer, Level>(init, allocator_t(alloc_script));
+
+        alloc_script.finalize();
+
+        return alloc_script;
+    }
+
+    /**
+     * @brief Passes constructor arguments of frozen container of level, which replays alloc_script, to construct
+     * @details pools points to pointer to pools of frozen object, containers of nested levels allocate from them
+     */
+    template<typename Initializer, std::size_t Level, typename Container, typename AllocScript, typename Pools, typename Construct>
+    constexpr auto replay_frozen(Container& init, const AllocScript& alloc_script, AllocScript& current_alloc_script, Pools pools, Construct construct)
+    {
+        using level = frozen_level_t<Initializer, Container, Level>;
+        using ContainerWithScriptAllocator = typename level::type;
+        using allocator_t = typename ContainerWithScriptAllocator::allocator_type;
+
+        typename level::context_type context { &alloc_script, &current_alloc_script };
+        if constexpr (level::pooled)
+        {
+            context.pool = (*pools)->template pool<Level>();
+        }
+        allocator_t allocator(context);
+
+        if constexpr (is_nested<Container>)
+        {
+            using factory = frozen_element_factory_t<Initializer, Container, Level, Pools>;
+            using iterator = element_builder_iterator_t<decltype(init.begin()), factory>;
+
+            return construct(constructor_args<ContainerWithScriptAllocator>(
+                    iterator { init.begin(), factory { pools } }, iterator { init.end(), factory { pools } }, init.size(), allocator));
+        }
+        else
+        {
+            return construct(constructor_args<ContainerWithScriptAllocator>(
+                    move_source_iterator(init, init.begin()), move_source_iterator(init, init.end()), init.size(), allocator));
+        }
+    }
+
+    /**
+     * @brief Prepares allocations script and allocator of frozen container of level and passes constructor
+     *        arguments of container to construct
+     * @details Nested containers are constructed in place with their own scripts. Scripts and allocator are
+     *          alived only during construct, allocators of constructed container are sealed by then.
+     */
+    template<typename Initializer, std::size_t Level, typename Container, typename Pools, typename Construct>
+    constexpr auto construct_frozen(Container& init, Pools pools, Construct construct)
+    {
+        auto alloc_script = get_alloc_script_impl<Initializer, Level>(init);
+
+        typename frozen_level_t<Initializer, Container, Level>::alloc_script_type current_alloc_script;
+
+        return replay_frozen<Initializer, Level>(init, alloc_script, current_alloc_script, pools, construct);
+    }
+
+    /**
+     * @brief Passes constructor arguments of frozen object of level 0, which replays alloc_script, to construct
+     * @details Frozen nested container takes pointer to its pools as first argument, it is set before nested
+     *          containers are constructed
+     */
+    template<typename Initializer, typename Container, typename AllocScript, typename Construct>
+    constexpr auto replay_result(Container& init, const AllocScript& alloc_script, AllocScript& current_alloc_script, Construct construct)
+    {
+        if constexpr (is_nested<Container>)
+        {
+            using pools_type = typename frozen_result_t<Initializer, Container>::pools_type;
+
+            pools_type* pools = nullptr;
+            return replay_frozen<Initializer, 0>(init, alloc_script, current_alloc_script, &pools, [&pools, construct](auto args)
+            {
+                return construct(std::tuple_cat(std::tuple<pools_type*&> { pools }, args));
+            });
+        }
+        else
+        {
+            return replay_frozen<Initializer, 0>(init, alloc_script, current_alloc_script, nullptr, construct);
+        }
+    }
+
+    template<typename Initializer, typename Container>
+    constexpr auto too_constexpr_impl(Container& init)
+    {
+        auto alloc_script = get_alloc_script_impl<Initializer, 0>(init);
+
+        typename frozen_level_t<Initializer, Container, 0>::alloc_script_type current_alloc_script;
+
+        return replay_result<Initializer>(init, alloc_script, current_alloc_script, [](auto args)
+        {
+            return std::make_from_tuple<frozen_result_t<Initializer, Container>>(args);
+        });
+    }
+
+    /**
+     * @brief Frozen containers produced by one initializer
+     * @details Members are constructed in place by aggregate initialization, because frozen container can't be moved.
+     *          Access is provided by get<Index>() and structured bindings.
+     */
+    template<typename... Containers>
+    struct frozen_tuple_t;
+
+    template<>
+    struct frozen_tuple_t<>
+    {};
+
+    template<typename Head, typename... Tail>
+    struct frozen_tuple_t<Head, Tail...>
+    {
+        template<std::size_t Index>
+        constexpr const auto& get() const
+        {
+            if constexpr (Index == 0)
+            {
+                return head;
+            }
+            else
+            {
+                return tail.template get<Index - 1>();
+            }
+        }
+
+        Head head;
+        [[no_unique_address]] frozen_tuple_t<Tail...> tail;
+    };
+
+    template<typename Initializer, typename Tuple, typename Indexes>
+    struct frozen_tuple_of;
+
+    template<typename Initializer, typename Tuple, std::size_t... Indexes>
+    struct frozen_tuple_of<Initializer, Tuple, std::index_sequence<Indexes...>>
+    {
+        using type = frozen_tuple_t<
+                frozen_result_t<member_initializer_t<Initializer, Indexes>, std::tuple_element_t<Indexes, Tuple>>...>;
+    };
+
+    template<typename Initializer, std::size_t Index, typename Result, typename Tuple>
+    constexpr Result too_constexpr_members(Tuple& init)
+    {
+        if constexpr (Index == std::tuple_size_v<Tuple>)
+        {
+            return Result {};
+        }
+        else
+        {
+            return Result {
+                too_constexpr_impl<member_initializer_t<Initializer, Index>>(std::get<Index>(init)),
+                too_constexpr_members<Initializer, Index + 1, decltype(Result::tail)>(init)
+            };
+        }
+    }
+
+    /**
+     * @details Initializer is evaluated once for sizing of every level of nested containers (type of result
+     *          depends on it, so it has to be separate constant evaluation) and once for construction of result.
+     *          Allocations scripts are transcribed from the same init value which is used for construction,
+     *          so initializer isn't evaluated for them.
+     *
+     *          If initializer returns tuple or pair of containers, result is frozen_tuple_t of frozen containers.
+     *          Sizing of all members is done in one evaluation (except of nested levels), all members are
+     *          constructed from one init value.
+     */
+    template<typename Initializer>
+    requires is_initializer<Initializer>
+    constexpr auto too_constexpr([[maybe_unused]] Initializer initalizer_labmda)
+    {
+        auto init = init_value<Initializer>();
+
+        if constexpr (is_tuple_like<init_value_type<Initializer>>)
+        {
+            using tuple_type = init_value_type<Initializer>;
+            using result_type = typename frozen_tuple_of<Initializer, tuple_type, std::make_index_sequence<std::tuple_size_v<tuple_type>>>::type;
+
+            return too_constexpr_members<Initializer, 0, result_type>(init);
+        }
+        else
+        {
+            return too_constexpr_impl<Initializer>(init);
+        }
+    }
+
+    template<typename Container>
+    constexpr std::size_t levels_num()
+    {
+        if constexpr (is_nested<Container>)
+        {
+            return 1 + levels_num<element_of_t<Container>>();
+        }
+        else
+        {
+            return 1;
+        }
+    }
+
+    /**
+     * @return Number of containers of all levels in init
+     */
+    template<typename Container>
+    constexpr std::size_t containers_num(const Container& init)
+    {
+        std::size_t result = 1;
+        if constexpr (is_nested<Container>)
+        {
+            for (const auto& value : init)
+            {
+                result += containers_num(element_value<Container>(value));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Costs of freezing of container by too_constexpr
+     * @details Allocations and operations are counted for top level container, nested containers are
+     *          frozen the same way with their own scripts
+     */
+    struct stats_t
+    {
+        // Levels of nested containers, initializer is evaluated levels + 1 times
+        std::size_t levels {};
+        // Containers of all levels, every one of them is copied once while allocations are counted
+        std::size_t counted_containers {};
+        // Allocations made by counting allocator, they are capacity of allocations script
+        std::size_t counted_allocations {};
+        // Allocations in script, they are counted, transcribed and replayed
+        std::size_t allocations {};
+        // Allocations which are deallocated during construction
+        std::size_t transient_allocations {};
+        // Allocations which are alived in frozen container
+        std::size_t surviving_allocations {};
+        // Objects in static storage of frozen container
+        std::size_t payload_objects {};
+        // Allocators (copies and rebinds) which allocate memory
+        std::size_t allocators {};
+        // Steps of search of deallocated pointers (get_index) during transcription
+        std::size_t transcription_lookup_steps {};
+        // Steps of search of deallocated pointers (get_index) during replay
+        std::size_t replay_lookup_steps {};
+        // Checks of end of script for allocator (finished_for_id) during replay
+        std::size_t replay_finished_checks {};
+    };
+
+    /**
+     * @brief Freezes result of initializer and reports costs of all phases
+     * @details It can be used in static_assert to limit costs of table:
+     *          @code
+     *          static_assert(cant::stats(initializer).allocations <= 10);
+     *          @endcode
+     */
+    template<typename Initializer>
+    requires (!is_tuple_like<init_value_type<Initializer>>)
+    constexpr stats_t stats([[maybe_unused]] Initializer initializer)
+    {
+        // Only scripts of counted initializer count their operations, so too_constexpr doesn't pay for it
+        using counted_initializer = counted_initializer_t<Initializer>;
+        using container_type = init_value_type<Initializer>;
+        using level = frozen_level_t<counted_initializer, container_type, 0>;
+
+        auto init = init_value<Initializer>();
+
+        stats_t result {
+            .levels = levels_num<container_type>(),
+            .counted_containers = containers_num(init),
+            .counted_allocations = level::allocations_count.allocations_num
+        };
+
+        auto alloc_script = get_alloc_script_impl<counted_initializer, 0>(init);
+
+        result.allocations = alloc_script.get_count();
+        result.transcription_lookup_steps = alloc_script.counters.lookup_steps;
+
+        for (const auto& entry : alloc_script)
+        {
+            if (entry.deallocated)
+            {
+                ++result.transient_allocations;
+            }
+            else
+            {
+                ++result.surviving_allocations;
+                result.payload_objects += entry.num;
+            }
+            result.allocators = std::max(result.allocators, entry.allocator_index + 1);
+        }
+
+        typename level::alloc_script_type current_alloc_script;
+        replay_result<counted_initializer>(init, alloc_script, current_alloc_script, [](auto args)
+        {
+            auto frozen = std::make_from_tuple<frozen_result_t<counted_initializer, container_type>>(args);
+            return frozen.size();
+        });
+
+        result.replay_lookup_steps = current_alloc_script.counters.lookup_steps;
+        result.replay_finished_checks = current_alloc_script.counters.finished_checks;
+
+        return result;
+    }
+
+    /**
+     * @brief Memory of frozen object, all of it is embedded into object
+     */
+    struct footprint_t
+    {
+        // Size of object
+        std::size_t total_bytes {};
+        // Bytes of values of innermost level (e.g. characters of strings of vector<string>)
+        std::size_t payload_bytes {};
+        // Bytes of state of allocators besides storage
+        std::size_t allocator_overhead_bytes {};
+        // Estimated number of embedded pointers, every one of them is dynamic relocation in PIE
+        std::size_t pointers {};
+    };
+
+    template<typename Container>
+    concept is_string = requires(const Container& container) { container.c_str(); };
+
+    template<typename Container>
+    constexpr void add_footprint(const Container& container, footprint_t& result)
+    {
+        using allocator_type = typename Container::allocator_type;
+        using value_type = typename Container::value_type;
+
+        if constexpr (requires { allocator_type::storage_bytes(); })
+        {
+            // Container embeds allocators of all rebinds (e.g. of nodes and of buckets), same container with
+            // empty allocator consists of its own fields only
+            using own_fields_type = rebind_allocator_to<Container, std::allocator<value_type>>;
+            result.allocator_overhead_bytes += sizeof(Container) - sizeof(own_fields_type) - allocator_type::storage_bytes();
+        }
+
+        // Pointers are estimated by usual layout of standard library containers
+        if constexpr (is_unordered<Container>)
+        {
+            // Pointer to next node in every node, non-empty buckets and pointer to buckets.
+            // Empty buckets are null, so they aren't relocated
+            std::size_t used_buckets = 0;
+            for (std::size_t i = 0; i < container.bucket_count(); ++i)
+            {
+                used_buckets += container.bucket_size(i) != 0 ? 1 : 0;
+            }
+            result.pointers += container.size() + used_buckets + 1;
+        }
+        else if constexpr (is_string<Container>)
+        {
+#if defined(__GLIBCXX__)
+            // Pointer refers to local buffer for short strings too
+            result.pointers += 1;
+#else
+            // Only long string refers to storage, short one keeps characters in object and has minimal capacity
+            using short_string_type = rebind_allocator_to<Container, std::allocator<value_type>>;
+            result.pointers += container.capacity() > short_string_type().capacity() ? 1 : 0;
+#endif
+        }
+        else
+        {
+            // Begin, end and end of capacity
+            result.pointers += container.capacity() > 0 ? 3 : 0;
+        }
+
+        if constexpr (is_nested<Container>)
+        {
+            for (const auto& value : container)
+            {
+                add_footprint(element_value<Container>(value), result);
+            }
+        }
+        else
+        {
+            result.payload_bytes += container.size() * sizeof(typename Container::value_type);
+        }
+    }
+
+    /**
+     * @details Values of nested levels are in pools, they are counted by containers, which own them
+     */
+    template<typename Pools, typename Container>
+    constexpr void add_footprint(const frozen_nested_t<Pools, Container>& frozen, footprint_t& result)
+    {
+        // Pools keep numbers of objects besides storages
+        result.allocator_overhead_bytes += sizeof(Pools) - Pools::storage_bytes();
+        add_footprint(static_cast<const Container&>(frozen), result);
+    }
+
+    /**
+     * @brief Memory of frozen container, it can be checked by static_assert
+     * @details Pointers are estimated by layout of containers, exact number of relocations is reported
+     *          by cant_footprint_report() from cmake/CantFootprint.cmake
+     */
+    template<typename Container>
+    constexpr footprint_t footprint(const Container& container)
+    {
+        footprint_t result { .total_bytes = sizeof(Container) };
+        add_footprint(container, result);
+        return result;
+    }
+
+    /**
+     * @brief Initializer which calls builder with arguments
+     * @details Arguments are part of type, so initializer is evaluated by type as usual. Builders of different
+     *          arguments are the same function, so its instantiations are shared.
+     */
+    template<typename Builder, auto... Args>
+    struct bound_initializer_t
+    {
+        constexpr auto operator()() const
+        {
+            return Builder()(Args...);
+        }
+    };
+
+    /**
+     * @brief Freezes result of builder(Args...)
+     * @details Builder must not capture any objects, arguments must be structural types, e.g. scalars or
+     *          aggregates with public members. It allows to produce family of tables with one builder:
+     *          @code
+     *          constexpr auto table = cant::too_constexpr<config_t { .size = 10 }>(builder);
+     *          @endcode
+     */
+    template<auto... Args, typename Builder>
+    requires (sizeof...(Args) > 0) && std::is_default_constructible_v<Builder>
+    constexpr auto too_constexpr([[maybe_unused]] Builder builder)
+    {
+        return too_constexpr(bound_initializer_t<Builder, Args...> {});
+    }
+
+    /**
+     * @brief Iterator over elements of segments of Container (segmented_t or sharded_t) one by one
+     */
+    template<typename Container>
+    struct segments_iterator_t
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = typename Container::value_type;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        constexpr reference operator*() const
+        {
+            return container->segment(segment)[position];
+        }
+
+        constexpr pointer operator->() const
+        {
+            return &**this;
+        }
+
+        constexpr segments_iterator_t& operator++()
+        {
+            ++position;
+            skip_finished_segments();
+            return *this;
+        }
+
+        constexpr segments_iterator_t operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        constexpr bool operator==(const segments_iterator_t& other) const
+        {
+            return segment == other.segment && position == other.position;
+        }
+
+        constexpr void skip_finished_segments()
+        {
+            while (segment < Container::segments_num() && position == container->segment(segment).size())
+            {
+                ++segment;
+                position = 0;
+            }
+        }
+
+        const Container* container {};
+        std::size_t segment {};
+        std::size_t position {};
+    };
+
+    /**
+     * @brief Read-only view of sequence stored in several contiguous segments
+     * @details Elements are accessed by index in O(log(SegmentsNum)) and iterated segment by segment
+     */
+    template<typename T, std::size_t SegmentsNum>
+    struct segmented_t
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using segment_type = std::span<const T>;
+        using iterator = segments_iterator_t<segmented_t>;
+
+        constexpr segmented_t(const std::array<segment_type, SegmentsNum>& segments)
+            : segments(segments)
+        {
+            for (std::size_t i = 0; i < SegmentsNum; ++i)
+            {
+                offsets[i + 1] = offsets[i] + segments[i].size();
+            }
+        }
+
+        constexpr const T& operator[](std::size_t index) const
+        {
+            auto segment = std::upper_bound(offsets.begin(), offsets.end(), index) - offsets.begin() - 1;
+            return segments[segment][index - offsets[segment]];
+        }
+
+        constexpr std::size_t size() const
+        {
+            return offsets[SegmentsNum];
+        }
+
+        constexpr bool empty() const
+        {
+            return size() == 0;
+        }
+
+        constexpr iterator begin() const
+        {
+            iterator result { this, 0, 0 };
+            result.skip_finished_segments();
+            return result;
+        }
+
+        constexpr iterator end() const
+        {
+            return { this, SegmentsNum, 0 };
+        }
+
+        constexpr segment_type segment(std::size_t index) const
+        {
+            return segments[index];
+        }
+
+        static constexpr std::size_t segments_num()
+        {
+            return SegmentsNum;
+        }
+
+        std::array<segment_type, SegmentsNum> segments;
+        std::array<std::size_t, SegmentsNum + 1> offsets {};
+    };
+
+    /**
+     * @brief Frozen segment with index of segmented container
+     * @details Every segment is separate static variable, so it is separate constant evaluation
+     *          with its own constexpr steps limit
+     */
+    template<typename Builder, std::size_t Index>
+    struct frozen_segment_t
+    {
+        static constexpr auto value = too_constexpr<Index>(Builder {});
+    };
+
+    /**
+     * @brief Freezes results of builder(0), ..., builder(SegmentsNum - 1) and joins them in segmented_t
+     * @details Builder must produce contiguous containers (vector or string) of the same value type.
+     *          Segments are evaluated independently, so size of whole container isn't limited by
+     *          constexpr steps limit, only size of segment is.
+     */
+    template<std::size_t SegmentsNum, typename Builder>
+    requires (SegmentsNum > 0) && std::is_default_constructible_v<Builder>
+    constexpr auto too_constexpr_segmented([[maybe_unused]] Builder builder)
+    {
+        return [&]<std::size_t... Indexes>(std::index_sequence<Indexes...>)
+        {
+            using value_type = typename std::remove_cvref_t<decltype(frozen_segment_t<Builder, 0>::value)>::value_type;
+            using result_type = segmented_t<value_type, SegmentsNum>;
+
+            return result_type({ typename result_type::segment_type(frozen_segment_t<Builder, Indexes>::value)... });
+        }(std::make_index_sequence<SegmentsNum> {});
+    }
+
+    /**
+     * @brief Read-only view of sequence, which shards are frozen in different translation units
+     * @details Shard is exported from its translation unit as constant initialized span:
+     *          @code
+     *          constexpr static auto table_0 = cant::too_constexpr<0>(builder);
+     *          extern constinit const std::span<const int> shard_0 = table_0;
+     *          @endcode
+     *          View refers to shards by addresses, which are constants, so view is constant initialized and it
+     *          isn't constructed at runtime. Sizes of shards are unknown in translation unit of view,
+     *          so access by index is O(ShardsNum).
+     */
+    template<typename T, std::size_t ShardsNum>
+    struct sharded_t
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using segment_type = std::span<const T>;
+        using iterator = segments_iterator_t<sharded_t>;
+
+        constexpr const T& operator[](std::size_t index) const
+        {
+            std::size_t shard = 0;
+            while (index >= shards[shard]->size())
+            {
+                index -= shards[shard]->size();
+                ++shard;
+            }
+            return (*shards[shard])[index];
+        }
+
+        constexpr std::size_t size() const
+        {
+            std::size_t result = 0;
+            for (auto* shard : shards)
+            {
+                result += shard->size();
+            }
+            return result;
+        }
+
+        constexpr bool empty() const
+        {
+            return size() == 0;
+        }
+
+        constexpr iterator begin() const
+        {
+            iterator result { this, 0, 0 };
+            result.skip_finished_segments();
+            return result;
+        }
+
+        constexpr iterator end() const
+        {
+            return { this, ShardsNum, 0 };
+        }
+
+        /**
+         * @brief First element which isn't less than value
+         * @details Shards must be sorted and every element of shard must not be less than elements of previous shards
+         */
+        template<typename Compare = std::less<>>
+        constexpr iterator lower_bound(const T& value, Compare compare = {}) const
+        {
+            for (std::size_t shard = 0; shard < ShardsNum; ++shard)
+            {
+                auto segment = *shards[shard];
+                auto it = std::lower_bound(segment.begin(), segment.end(), value, compare);
+                if (it != segment.end())
+                {
+                    return { this, shard, static_cast<std::size_t>(it - segment.begin()) };
+                }
+            }
+            return end();
+        }
+
+        template<typename Compare = std::less<>>
+        constexpr bool contains(const T& value, Compare compare = {}) const
+        {
+            auto it = lower_bound(value, compare);
+            return it != end() && !compare(value, *it);
+        }
+
+        constexpr segment_type segment(std::size_t index) const
+        {
+            return *shards[index];
+        }
+
+        static constexpr std::size_t segments_num()
+        {
+            return ShardsNum;
+        }
+
+        std::array<const segment_type*, ShardsNum> shards;
+    };
+
+    /**
+     * @brief Read-only handle of contiguous table, which is frozen or constructed at runtime
+     * @details Type of handle depends only on type of values, so callers don't depend on the way table is built.
+     *          Handle is constant initialized in both cases: it refers to frozen table or to function which
+     *          constructs table once at first access.
+     */
+    template<typename T>
+    struct maybe_frozen_t
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using const_iterator = const T*;
+        using iterator = const_iterator;
+
+        std::span<const T> view() const
+        {
+            return runtime_view ? runtime_view() : frozen_view;
+        }
+
+        const T& operator[](std::size_t index) const
+        {
+            return view()[index];
+        }
+
+        const T* data() const
+        {
+            return view().data();
+        }
+
+        std::size_t size() const
+        {
+            return view().size();
+        }
+
+        bool empty() const
+        {
+            return view().empty();
+        }
+
+        const_iterator begin() const
+        {
+            return data();
+        }
+
+        const_iterator end() const
+        {
+            return data() + size();
+        }
+
+        /**
+         * @return true, if table is frozen at compile time
+         */
+        constexpr bool frozen() const
+        {
+            return !runtime_view;
+        }
+
+        std::span<const T> frozen_view {};
+        std::span<const T> (*runtime_view)() {};
+    };
+
+    template<typename Initializer>
+    struct frozen_value_t
+    {
+        static constexpr auto value = too_constexpr(Initializer {});
+    };
+
+    /**
+     * @details It isn't constexpr, so initialization of static by its result isn't tried at compile time
+     */
+    template<typename Initializer>
+    init_value_type<Initializer> runtime_init_value()
+    {
+        return Initializer()();
+    }
+
+    /**
+     * @brief Table constructed by Initializer at first call (thread-safe)
+     */
+    template<typename Initializer>
+    std::span<const typename init_value_type<Initializer>::value_type> runtime_value()
+    {
+        static const auto value = runtime_init_value<Initializer>();
+        return value;
+    }
+
+    /**
+     * @brief Default budget of cant::maybe_constexpr
+     * @details Vector of ints of this size, which is built by push_back, is counted, transcribed and replayed
+     *          within default limit of constexpr steps of clang with twofold margin. Budget doesn't depend on
+     *          costs of initializer, so tables with expensive initializers need smaller one
+     */
+    inline constexpr std::size_t DefaultMaxPayloadBytes = 16 * 1024;
+
+    /**
+     * @brief Freezes result of initializer if it fits budget, otherwise it is constructed at runtime at first access
+     * @details Initializer must produce contiguous container (vector or string) of at most Size values. Budget is
+     *          checked by declared Size, so initializer of table over budget isn't evaluated at compile time at all.
+     *          Table can be constructed eagerly by call of view() at startup. Size is checked by frozen table, so
+     *          initializer isn't evaluated again for the check.
+     *          @code
+     *          constinit const auto table = cant::maybe_constexpr<1000>(initializer);
+     *          @endcode
+     */
+    template<std::size_t Size, std::size_t MaxPayloadBytes = DefaultMaxPayloadBytes, typename Initializer>
+    constexpr auto maybe_constexpr([[maybe_unused]] Initializer initializer)
+    {
+        using value_type = typename init_value_type<Initializer>::value_type;
+
+        if constexpr (Size * sizeof(value_type) <= MaxPayloadBytes)
+        {
+            static_assert(frozen_value_t<Initializer>::value.size() <= Size, "Initializer produces more values than declared");
+
+            return maybe_frozen_t<value_type> { .frozen_view = frozen_value_t<Initializer>::value };
+        }
+        else
+        {
+            return maybe_frozen_t<value_type> { .runtime_view = &runtime_value<Initializer> };
+        }
+    }
+
+    template<typename T, std::size_t Num>
+    constexpr alived_counts_t<ObjectTypesMaxNum> generated_alived_counts()
+    {
+        alived_counts_t<ObjectTypesMaxNum> result;
+        result.add(type_id<T>(), sizeof(T), Num);
+        return result;
+    }
+
+    /**
+     * @brief Iterator over values generator(0), generator(1), ...
+     */
+    template<typename Generator>
+    struct generator_iterator_t
+    {
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<std::invoke_result_t<const Generator&, std::size_t>>;
+        using pointer = void;
+        using reference = value_type;
+
+        constexpr reference operator*() const
+        {
+            return (*generator)(index);
+        }
+
+        constexpr generator_iterator_t& operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        constexpr generator_iterator_t operator++(int)
+        {
+            auto result = *this;
+            ++index;
+            return result;
+        }
+
+        constexpr friend bool operator==(const generator_iterator_t& lhs, const generator_iterator_t& rhs)
+        {
+            return lhs.index == rhs.index;
+        }
+
+        const Generator* generator;
+        std::size_t index;
+    };
+
+    /**
+     * @brief Creates frozen vector of Num values generator(0), ..., generator(Num - 1)
+     * @details Size of result is known, so allocations aren't counted and transcribed: allocator is sealed
+     *          since construction and values are constructed directly in its storage in one pass
+     */
+    template<std::size_t Num, typename Generator>
+    constexpr auto generate(Generator generator)
+    {
+        using iterator = generator_iterator_t<Generator>;
+        using T = typename iterator::value_type;
+        using alloc_script_type = alloc_script_t<0>;
+        using context_type = replay_context_t<alloc_script_type>;
+        using allocator_t = script_allocator_t<T, context_type, generated_alived_counts<T, Num>()>;
+
+        alloc_script_type empty_script;
+        alloc_script_type current_alloc_script;
+        context_type context { &empty_script, &current_alloc_script };
+        allocator_t allocator(context);
+
+        return std::vector<T, allocator_t>(iterator { &generator, 0 }, iterator { &generator, Num }, allocator);
     }
 } // namespace cant
+
+template<typename... Containers>
+struct std::tuple_size<cant::frozen_tuple_t<Containers...>> : std::integral_constant<std::size_t, sizeof...(Containers)> {};
+
+template<std::size_t Index, typename... Containers>
+struct std::tuple_element<Index, cant::frozen_tuple_t<Containers...>>
+{
+    using type = const std::tuple_element_t<Index, std::tuple<Containers...>>;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "cant_baked.h"
+
+#include <cstdint>
+#include <ios>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace cant
+{
+    /**
+     * @brief Name of type of baked values in generated header
+     * @details Only arithmetic types are supported, because values are written as literals
+     */
+    template<typename T>
+    constexpr std::string_view baked_type_name()
+    {
+        if constexpr (std::is_same_v<T, bool>) return "bool";
+        else if constexpr (std::is_same_v<T, char>) return "char";
+        else if constexpr (std::is_same_v<T, signed char>) return "signed char";
+        else if constexpr (std::is_same_v<T, unsigned char>) return "unsigned char";
+        else if constexpr (std::is_same_v<T, char8_t>) return "char8_t";
+        else if constexpr (std::is_same_v<T, char16_t>) return "char16_t";
+        else if constexpr (std::is_same_v<T, char32_t>) return "char32_t";
+        else if constexpr (std::is_same_v<T, wchar_t>) return "wchar_t";
+        else if constexpr (std::is_same_v<T, short>) return "short";
+        else if constexpr (std::is_same_v<T, unsigned short>) return "unsigned short";
+        else if constexpr (std::is_same_v<T, int>) return "int";
+        else if constexpr (std::is_same_v<T, unsigned int>) return "unsigned int";
+        else if constexpr (std::is_same_v<T, long>) return "long";
+        else if constexpr (std::is_same_v<T, unsigned long>) return "unsigned long";
+        else if constexpr (std::is_same_v<T, long long>) return "long long";
+        else if constexpr (std::is_same_v<T, unsigned long long>) return "unsigned long long";
+        else if constexpr (std::is_same_v<T, float>) return "float";
+        else if constexpr (std::is_same_v<T, double>) return "double";
+        else if constexpr (std::is_same_v<T, long double>) return "long double";
+        else static_assert(std::is_arithmetic_v<T>, "Only containers of arithmetic values can be baked");
+    }
+
+    /**
+     * @brief Writes value as literal, which is converted to T without loss
+     * @details Characters are written as numbers, floating point values in hexadecimal format
+     */
+    template<typename T>
+    void write_baked_value(std::ostream& out, T value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            out << (value ? "true" : "false");
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            out << std::hexfloat << value << std::defaultfloat;
+            if constexpr (std::is_same_v<T, float>) out << 'f';
+            if constexpr (std::is_same_v<T, long double>) out << 'L';
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            // Minimal value can't be written as negated literal
+            if (value == std::numeric_limits<T>::min())
+            {
+                out << '(' << static_cast<std::intmax_t>(value) + 1 << " - 1)";
+            }
+            else
+            {
+                out << static_cast<std::intmax_t>(value);
+            }
+        }
+        else
+        {
+            out << static_cast<std::uintmax_t>(value) << 'u';
+        }
+    }
+
+    template<typename Container>
+    concept is_baked_string = requires(const Container& container) { container.c_str(); };
+
+    /**
+     * @brief Writes generated header with constant name, which contains values of container
+     * @details Container is vector or string of arithmetic values (e.g. result of initializer of too_constexpr,
+     *          evaluated at runtime). Constant is baked_vector_t or baked_string_t, so generated header
+     *          doesn't depend on cant.h and it doesn't evaluate anything at compile time.
+     */
+    template<typename Container>
+    void write_baked(std::ostream& out, std::string_view name, const Container& container)
+    {
+        using value_type = typename Container::value_type;
+
+        out << "// Generated by cant_bake, don't edit\n"
+            << "#pragma once\n\n"
+            << "#include \"cant_baked.h\"\n\n"
+            << "inline constexpr cant::"
+            << (is_baked_string<Container> ? "baked_string_t<" : "baked_vector_t<")
+            << baked_type_name<value_type>() << ", " << container.size() << "> " << name << " { {";
+
+        std::size_t index = 0;
+        for (const auto& value : container)
+        {
+            out << (index % 16 == 0 ? "\n    " : " ");
+            write_baked_value<value_type>(out, value);
+            out << ',';
+            ++index;
+        }
+
+        if constexpr (is_baked_string<Container>)
+        {
+            out << (index % 16 == 0 ? "\n    " : " ") << '0';
+        }
+
+        out << "\n} };\n";
+    }
+} // namespace cant
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace cant
+{
+    /**
+     * @brief Baked vector: values of frozen vector which are written to generated header as literal array
+     * @details Provides read-only interface of frozen vector, so baked table can replace result of too_constexpr
+     */
+    template<typename T, std::size_t Size>
+    struct baked_vector_t
+    {
+        using value_type = T;
+        using size_type = std::size_t;
+        using const_iterator = const T*;
+        using iterator = const_iterator;
+
+        constexpr const T& operator[](std::size_t index) const
+        {
+            return values[index];
+        }
+
+        constexpr const T* data() const
+        {
+            return values.data();
+        }
+
+        static constexpr std::size_t size()
+        {
+            return Size;
+        }
+
+        static constexpr std::size_t capacity()
+        {
+            return Size;
+        }
+
+        static constexpr bool empty()
+        {
+            return Size == 0;
+        }
+
+        constexpr const T& front() const
+        {
+            return values.front();
+        }
+
+        constexpr const T& back() const
+        {
+            return values.back();
+        }
+
+        constexpr const_iterator begin() const
+        {
+            return data();
+        }
+
+        constexpr const_iterator end() const
+        {
+            return data() + Size;
+        }
+
+        std::array<T, Size> values;
+    };
+
+    /**
+     * @brief Baked string: characters of frozen string with terminating null
+     */
+    template<typename CharT, std::size_t Size>
+    struct baked_string_t
+    {
+        using value_type = CharT;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using iterator = const_iterator;
+
+        constexpr const CharT& operator[](std::size_t index) const
+        {
+            return values[index];
+        }
+
+        constexpr const CharT* data() const
+        {
+            return values.data();
+        }
+
+        constexpr const CharT* c_str() const
+        {
+            return values.data();
+        }
+
+        static constexpr std::size_t size()
+        {
+            return Size;
+        }
+
+        static constexpr std::size_t length()
+        {
+            return Size;
+        }
+
+        static constexpr bool empty()
+        {
+            return Size == 0;
+        }
+
+        constexpr const_iterator begin() const
+        {
+            return data();
+        }
+
+        constexpr const_iterator end() const
+        {
+            return data() + Size;
+        }
+
+        constexpr operator std::basic_string_view<CharT>() const
+        {
+            return { data(), Size };
+        }
+
+        friend constexpr bool operator==(const baked_string_t& string, std::basic_string_view<CharT> other)
+        {
+            return std::basic_string_view<CharT>(string) == other;
+        }
+
+        std::array<CharT, Size + 1> values;
+    };
+} // namespace cant
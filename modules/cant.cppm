@@ -0,0 +1,24 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module cant;
+
+// Whole header is exported, so module provides the same names as cant.h (too_constexpr, maybe_constexpr, stats,
+// footprint, maybe_frozen_t, stats_t, footprint_t...). Standard headers are included above, so here only declarations
+// of cant.h are attached to module
+export
+{
+#include "cant.h"
+}
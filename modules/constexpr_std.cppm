@@ -0,0 +1,15 @@
+module;
+
+#include "constexpr_std/unordered_map"
+
+export module constexpr_std;
+
+// Constexpr port replaces std::unordered_map, so its names are exported from std like in standard library module
+export namespace std
+{
+    using std::unordered_map;
+    using std::unordered_multimap;
+    using std::operator==;
+    using std::erase_if;
+    using std::swap;
+}
@@ -0,0 +1,36 @@
+module;
+
+#include <string>
+#include <vector>
+
+export module cant.example_tables;
+
+import cant;
+
+constexpr auto squares_initializer = []() -> std::vector<int>
+{
+    std::vector<int> result;
+    for (int i = 0; i < 10; ++i)
+    {
+        result.push_back(i * i);
+    }
+    return result;
+};
+
+/**
+ * Frozen objects of module interface are evaluated once, when interface is compiled.
+ * Their values are stored in BMI, so importers don't evaluate initializers again.
+ */
+export inline constexpr auto squares_table = cant::too_constexpr(squares_initializer);
+
+export inline constexpr auto greeting_table = cant::too_constexpr(
+        []() -> std::string
+        {
+            std::string result("Hello, ");
+            result += "modules";
+            return result;
+        }
+);
+
+// Costs of freezing of squares_table, importers check them without evaluation of cant::stats
+export inline constexpr auto squares_stats = cant::stats(squares_initializer);
@@ -0,0 +1,24 @@
+#include <cstddef>
+
+import cant.example_tables;
+
+// This file is compiled with limit of constexpr steps, which is much less than evaluation of cant::stats
+// or freezing of tables takes, so values below are read from BMI instead of being evaluated again
+static_assert(squares_stats.levels == 1 && squares_stats.allocations == 1, "error");
+static_assert(squares_stats.payload_objects == 10 && squares_stats.transient_allocations == 0, "error");
+
+// GCC can't use frozen objects in constant expressions, they are checked by other compilers only
+#if !defined(__GNUC__) || defined(__clang__)
+static_assert(squares_table.size() == 10 && squares_table[9] == 81, "error");
+static_assert(greeting_table == "Hello, modules", "error");
+#endif
+
+int squares_sum()
+{
+    int result = 0;
+    for (std::size_t i = 0; i < squares_table.size(); ++i)
+    {
+        result += squares_table[i];
+    }
+    return result;
+}